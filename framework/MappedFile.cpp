@@ -0,0 +1,111 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nph
+{
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::filesystem::path& path)
+{
+	close();
+
+#ifdef _WIN32
+	const HANDLE file = CreateFileW(
+		path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	HANDLE mapping = nullptr;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+	{
+		mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+
+	// The view keeps the mapping and the file alive
+	CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		return false;
+	}
+
+	const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == nullptr)
+	{
+		return false;
+	}
+
+	mData = static_cast<const uint8_t*>(data);
+	mSize = static_cast<size_t>(size.QuadPart);
+#else
+	const int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat status;
+	void* data = MAP_FAILED;
+	if (fstat(file, &status) == 0 && status.st_size > 0)
+	{
+		data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	}
+
+	// The mapping keeps the file alive
+	::close(file);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	mData = static_cast<const uint8_t*>(data);
+	mSize = static_cast<size_t>(status.st_size);
+#endif
+	return true;
+}
+
+void MappedFile::close() noexcept
+{
+	if (mData == nullptr)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(mData);
+#else
+	munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+	mData = nullptr;
+	mSize = 0;
+}
+
+} // namespace nph
@@ -0,0 +1,50 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace nph
+{
+
+/// Read-only memory-mapped file
+class MappedFile
+{
+public:
+	/// Default constructor
+	MappedFile() noexcept = default;
+
+	/// Destructor, unmaps the file
+	~MappedFile();
+
+	/// Non-copyable
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// Maps a file, unmapping the previous one
+	/// \return true on success; empty files can not be mapped
+	bool open(const std::filesystem::path& path);
+
+	/// Unmaps the file
+	void close() noexcept;
+
+	/// Returns the mapped data, empty if no file is mapped
+	[[nodiscard]] std::span<const uint8_t> getData() const noexcept
+	{
+		return { mData, mSize };
+	}
+
+private:
+	/// Mapped data
+	const uint8_t* mData{ nullptr };
+
+	/// Size of the mapped data
+	size_t mSize{ 0 };
+};
+
+} // namespace nph
@@ -0,0 +1,435 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "Trajectory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace nph
+{
+
+namespace
+{
+
+/// Number of 32-bit words of a body transform
+constexpr size_t WORDS_PER_TRANSFORM = sizeof(BodyTransform) / sizeof(uint32_t);
+static_assert(sizeof(BodyTransform) == WORDS_PER_TRANSFORM * sizeof(uint32_t));
+
+/// Minimum length of an LZ match
+constexpr size_t LZ_MIN_MATCH = 4;
+
+/// Number of bits of the LZ match hash table
+constexpr uint32_t LZ_HASH_BITS = 14;
+
+/// Maximum number of bytes of a varint of uint64_t
+constexpr uint32_t MAX_VARINT_SIZE = 10;
+
+/// Appends a value as a varint: 7 bits per byte, the high bit marks continuation
+void writeVarint(std::vector<uint8_t>& output, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		output.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	output.push_back(static_cast<uint8_t>(value));
+}
+
+/// Reads a varint at the position and advances it
+/// \return true on success
+[[nodiscard]] bool readVarint(
+	std::span<const uint8_t> input,
+	size_t& position,
+	uint64_t& value) noexcept
+{
+	value = 0;
+	for (uint32_t i = 0; i < MAX_VARINT_SIZE && position < input.size(); ++i)
+	{
+		const uint8_t byte = input[position++];
+		value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/// Reads 4 bytes as a 32-bit value
+[[nodiscard]] uint32_t load32(const uint8_t* data) noexcept
+{
+	uint32_t value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+/// XORs the words with the previous frame and splits them into byte planes;
+/// the unchanged high bytes of the floats become runs of zeros
+void encodePlanes(
+	const std::vector<uint32_t>& words,
+	const std::vector<uint32_t>& previousWords,
+	std::vector<uint8_t>& planes)
+{
+	const size_t count = words.size();
+	planes.resize(count * sizeof(uint32_t));
+	for (size_t i = 0; i < count; ++i)
+	{
+		const uint32_t word = words[i] ^
+			(i < previousWords.size() ? previousWords[i] : 0u);
+
+		for (size_t b = 0; b < sizeof(uint32_t); ++b)
+		{
+			planes[b * count + i] = static_cast<uint8_t>(word >> (8 * b));
+		}
+	}
+}
+
+/// Inverse of encodePlanes
+void decodePlanes(
+	const std::vector<uint8_t>& planes,
+	const std::vector<uint32_t>& previousWords,
+	uint32_t* words) noexcept
+{
+	const size_t count = planes.size() / sizeof(uint32_t);
+	for (size_t i = 0; i < count; ++i)
+	{
+		uint32_t word = 0;
+		for (size_t b = 0; b < sizeof(uint32_t); ++b)
+		{
+			word |= static_cast<uint32_t>(planes[b * count + i]) << (8 * b);
+		}
+		words[i] = word ^ (i < previousWords.size() ? previousWords[i] : 0u);
+	}
+}
+
+/// Compresses data with a simple LZ77 scheme
+/// The output is a sequence of (literal count, literals, match length - LZ_MIN_MATCH,
+/// match offset) records with varint numbers; the last record has only literals
+void compressLz(const std::vector<uint8_t>& input, std::vector<uint8_t>& output)
+{
+	output.clear();
+	std::vector<uint32_t> table(size_t{ 1 } << LZ_HASH_BITS, 0);
+
+	const size_t size = input.size();
+	size_t literalStart = 0;
+	size_t position = 0;
+	while (position + LZ_MIN_MATCH <= size)
+	{
+		const uint32_t value = load32(&input[position]);
+		const uint32_t hash = (value * 2654435761u) >> (32 - LZ_HASH_BITS);
+
+		// Table entries are positions + 1, 0 marks an empty entry
+		const size_t candidate = table[hash];
+		table[hash] = static_cast<uint32_t>(position + 1);
+		if (candidate == 0 || load32(&input[candidate - 1]) != value)
+		{
+			++position;
+			continue;
+		}
+
+		const size_t matchStart = candidate - 1;
+		size_t length = LZ_MIN_MATCH;
+		while (position + length < size &&
+			input[matchStart + length] == input[position + length])
+		{
+			++length;
+		}
+
+		writeVarint(output, position - literalStart);
+		output.insert(
+			output.end(),
+			input.begin() + literalStart,
+			input.begin() + position);
+		writeVarint(output, length - LZ_MIN_MATCH);
+		writeVarint(output, position - matchStart);
+
+		position += length;
+		literalStart = position;
+	}
+
+	writeVarint(output, size - literalStart);
+	output.insert(output.end(), input.begin() + literalStart, input.end());
+}
+
+/// Decompresses data written by compressLz
+/// \return true if the data is valid and has the expected size
+[[nodiscard]] bool decompressLz(
+	std::span<const uint8_t> input,
+	std::vector<uint8_t>& output,
+	size_t expectedSize)
+{
+	output.clear();
+	output.reserve(expectedSize);
+
+	size_t position = 0;
+	for (;;)
+	{
+		uint64_t literalCount;
+		if (!readVarint(input, position, literalCount) ||
+			literalCount > input.size() - position ||
+			literalCount > expectedSize - output.size())
+		{
+			return false;
+		}
+
+		output.insert(
+			output.end(),
+			input.begin() + position,
+			input.begin() + position + literalCount);
+		position += literalCount;
+
+		if (position == input.size())
+		{
+			return output.size() == expectedSize;
+		}
+
+		uint64_t length;
+		uint64_t offset;
+		if (!readVarint(input, position, length) ||
+			!readVarint(input, position, offset) ||
+			expectedSize - output.size() < LZ_MIN_MATCH ||
+			length > expectedSize - output.size() - LZ_MIN_MATCH ||
+			offset == 0 ||
+			offset > output.size())
+		{
+			return false;
+		}
+
+		// The match can overlap the output, so the bytes are copied one by one
+		const size_t matchStart = output.size() - offset;
+		for (size_t i = 0; i < length + LZ_MIN_MATCH; ++i)
+		{
+			output.push_back(output[matchStart + i]);
+		}
+	}
+}
+
+} // anonymous namespace
+
+bool TrajectoryWriter::open(const std::filesystem::path& path, bool compress)
+{
+	mFile.open(path, std::ios::binary | std::ios::trunc);
+	mCompress = compress;
+	mPreviousWords.clear();
+
+	const TrajectoryHeader header{
+		TrajectoryHeader::MAGIC,
+		TrajectoryHeader::VERSION,
+		sizeof(BodyTransform),
+		NPH_SCALAR };
+
+	mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	return isGood();
+}
+
+bool TrajectoryWriter::writeFrame(uint32_t step, const BodyArray& bodies)
+{
+	if (!isGood())
+	{
+		return false;
+	}
+
+	const uint32_t bodyCount = static_cast<uint32_t>(bodies.size());
+	mWords.resize(bodyCount * WORDS_PER_TRANSFORM);
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		const BodyTransform transform{
+			bodies[i].position,
+			bodies[i].rotation.getAngle() };
+		std::memcpy(&mWords[i * WORDS_PER_TRANSFORM], &transform, sizeof(transform));
+	}
+
+	TrajectoryFrameHeader header{
+		step,
+		bodyCount,
+		static_cast<uint32_t>(mWords.size() * sizeof(uint32_t)),
+		TrajectoryFrameHeader::RAW };
+	const void* payload = mWords.data();
+
+	if (mCompress)
+	{
+		encodePlanes(mWords, mPreviousWords, mPlanes);
+		compressLz(mPlanes, mCompressed);
+		if (mCompressed.size() < header.payloadSize)
+		{
+			header.payloadSize = static_cast<uint32_t>(mCompressed.size());
+			header.encoding = TrajectoryFrameHeader::COMPRESSED;
+			payload = mCompressed.data();
+		}
+	}
+
+	mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	mFile.write(static_cast<const char*>(payload), header.payloadSize);
+
+	if (mCompress)
+	{
+		mPreviousWords.swap(mWords);
+	}
+	return isGood();
+}
+
+bool TrajectoryWriter::close()
+{
+	mFile.flush();
+	const bool result = isGood();
+	mFile.close();
+	return result;
+}
+
+TrajectoryReader::TrajectoryReader(uint32_t maxBodyCount) :
+	mMaxBodyCount(maxBodyCount)
+{
+	assert(mMaxBodyCount > 0);
+}
+
+bool TrajectoryReader::open(const std::filesystem::path& path)
+{
+	mData = {};
+	mFile.close();
+	mFile.clear();
+	mFile.open(path, std::ios::binary);
+	return readHeader();
+}
+
+bool TrajectoryReader::open(std::span<const uint8_t> data)
+{
+	mFile.close();
+	mData = data;
+	mDataPosition = 0;
+	return readHeader();
+}
+
+bool TrajectoryReader::readFrame(TrajectoryFrame& frame)
+{
+	TrajectoryFrameHeader header;
+	if (const size_t readSize = readBytes(&header, sizeof(header));
+		readSize != sizeof(header))
+	{
+		// A clean end of file is possible only at a frame boundary
+		mIsAtEnd = readSize == 0;
+		return false;
+	}
+
+	if (header.bodyCount > mMaxBodyCount)
+	{
+		return false;
+	}
+
+	const size_t wordCount = size_t{ header.bodyCount } * WORDS_PER_TRANSFORM;
+	const size_t rawSize = wordCount * sizeof(uint32_t);
+
+	// The writer compresses a frame only if the compression reduces its size
+	std::span<const uint8_t> payload;
+	if ((header.encoding == TrajectoryFrameHeader::RAW &&
+		header.payloadSize != rawSize) ||
+		(header.encoding == TrajectoryFrameHeader::COMPRESSED &&
+		header.payloadSize >= rawSize) ||
+		!readPayload(header.payloadSize, payload))
+	{
+		return false;
+	}
+
+	frame.step = header.step;
+	frame.transforms.resize(header.bodyCount);
+	uint32_t* const words = reinterpret_cast<uint32_t*>(frame.transforms.data());
+
+	switch (header.encoding)
+	{
+	case TrajectoryFrameHeader::RAW:
+		std::memcpy(words, payload.data(), rawSize);
+		break;
+
+	case TrajectoryFrameHeader::COMPRESSED:
+		if (!decompressLz(payload, mPlanes, rawSize))
+		{
+			return false;
+		}
+		decodePlanes(mPlanes, mPreviousWords, words);
+		break;
+
+	default:
+		return false;
+	}
+
+	mPreviousWords.assign(words, words + wordCount);
+	return true;
+}
+
+bool TrajectoryReader::readHeader()
+{
+	mIsAtEnd = false;
+	mPreviousWords.clear();
+
+	TrajectoryHeader header;
+	return
+		readBytes(&header, sizeof(header)) == sizeof(header) &&
+		header.magic == TrajectoryHeader::MAGIC &&
+		header.version == TrajectoryHeader::VERSION &&
+		header.transformSize == sizeof(BodyTransform) &&
+		header.scalarType == NPH_SCALAR;
+}
+
+size_t TrajectoryReader::readBytes(void* data, size_t size)
+{
+	if (!mFile.is_open())
+	{
+		const size_t readSize = std::min(size, mData.size() - mDataPosition);
+		if (readSize != 0)
+		{
+			std::memcpy(data, mData.data() + mDataPosition, readSize);
+			mDataPosition += readSize;
+		}
+		return readSize;
+	}
+
+	mFile.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+	return static_cast<size_t>(mFile.gcount());
+}
+
+bool TrajectoryReader::readPayload(
+	size_t size,
+	std::span<const uint8_t>& payload)
+{
+	if (!mFile.is_open())
+	{
+		// The payload is used in place
+		if (size > mData.size() - mDataPosition)
+		{
+			return false;
+		}
+		payload = mData.subspan(mDataPosition, size);
+		mDataPosition += size;
+		return true;
+	}
+
+	mPayload.resize(size);
+	if (readBytes(mPayload.data(), size) != size)
+	{
+		return false;
+	}
+	payload = mPayload;
+	return true;
+}
+
+bool convertTrajectoryToText(TrajectoryReader& reader, std::ostream& output)
+{
+	TrajectoryFrame frame;
+	while (reader.readFrame(frame))
+	{
+		output << "Step " << frame.step << ":\n";
+		for (size_t i = 0; i < frame.transforms.size(); ++i)
+		{
+			const BodyTransform& transform = frame.transforms[i];
+			output << "Body " << i << ": ";
+			output << "Pos(" << static_cast<double>(transform.position.x) << ", " <<
+				static_cast<double>(transform.position.y) << ") ";
+			output << "Rot(" << static_cast<double>(transform.angle) << ")\n";
+		}
+		output << "\n";
+	}
+	return reader.isAtEnd() && output.good();
+}
+
+} // namespace nph
@@ -0,0 +1,206 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+#include "neat_physics/Body.h"
+#include "neat_physics/StateEncoder.h"
+
+namespace nph
+{
+
+/// Header of a binary trajectory file
+/// The header is followed by the frames; each frame is a TrajectoryFrameHeader
+/// followed by the payload with the body transforms. The values are stored
+/// bit-exactly in the native byte order.
+struct TrajectoryHeader
+{
+	/// File signature
+	static constexpr uint32_t MAGIC = 0x5254504E; // "NPTR"
+
+	/// Format version
+	static constexpr uint32_t VERSION = 1;
+
+	/// File signature
+	uint32_t magic;
+
+	/// Format version
+	uint32_t version;
+
+	/// Size of BodyTransform, checks the layout
+	uint32_t transformSize;
+
+	/// Scalar type of the engine (NPH_SCALAR), checks the layout
+	uint32_t scalarType;
+};
+
+/// Header of a trajectory frame
+struct TrajectoryFrameHeader
+{
+	/// Payload encodings
+	enum Encoding : uint32_t
+	{
+		/// Array of BodyTransform
+		RAW = 0,
+
+		/// The transform words XORed with the previous frame,
+		/// split into byte planes and LZ-compressed
+		COMPRESSED = 1
+	};
+
+	/// Simulation step
+	uint32_t step;
+
+	/// Number of bodies
+	uint32_t bodyCount;
+
+	/// Payload size in bytes
+	uint32_t payloadSize;
+
+	/// Payload encoding
+	uint32_t encoding;
+};
+
+/// Frame of a trajectory
+struct TrajectoryFrame
+{
+	/// Simulation step
+	uint32_t step{ 0 };
+
+	/// Body transforms
+	std::vector<BodyTransform> transforms;
+};
+
+/// Streaming writer of binary trajectories
+class TrajectoryWriter
+{
+public:
+	/// Creates the file and writes the header
+	/// \param compress Enables compression of the frames; a frame is stored
+	/// uncompressed if the compression does not reduce its size
+	/// \return true on success
+	bool open(const std::filesystem::path& path, bool compress);
+
+	/// Checks if the file is open and no write errors occurred
+	[[nodiscard]] bool isGood() const
+	{
+		return mFile.is_open() && mFile.good();
+	}
+
+	/// Appends a frame with the transforms of the bodies
+	/// \return true on success
+	bool writeFrame(uint32_t step, const BodyArray& bodies);
+
+	/// Flushes and closes the file
+	/// \return true if all data was written
+	bool close();
+
+private:
+	/// File
+	std::ofstream mFile;
+
+	/// Compression flag
+	bool mCompress{ false };
+
+	/// Transform words of the previous frame
+	std::vector<uint32_t> mPreviousWords;
+
+	/// Transform words of the current frame
+	std::vector<uint32_t> mWords;
+
+	/// Byte planes of the current frame
+	std::vector<uint8_t> mPlanes;
+
+	/// Compressed payload
+	std::vector<uint8_t> mCompressed;
+};
+
+/// Streaming reader of binary trajectories
+/// The trajectory is read either from a file or from memory, e.g. from a
+/// memory-mapped file; in the latter case the memory must outlive the reader
+class TrajectoryReader
+{
+public:
+	/// Default maximum number of bodies of a frame
+	static constexpr uint32_t DEFAULT_MAX_BODY_COUNT = 1u << 20;
+
+	/// Constructor
+	/// \param maxBodyCount The maximum number of bodies of a frame;
+	/// the frame headers are not trusted to size the decoded frames
+	/// before the payload is read; asserted to be > 0
+	explicit TrajectoryReader(uint32_t maxBodyCount = DEFAULT_MAX_BODY_COUNT);
+
+	/// Returns the maximum number of bodies of a frame
+	[[nodiscard]] uint32_t getMaxBodyCount() const noexcept
+	{
+		return mMaxBodyCount;
+	}
+
+	/// Opens the file and reads the header
+	/// \return true on success
+	bool open(const std::filesystem::path& path);
+
+	/// Opens a trajectory stored in memory and reads the header
+	/// \return true on success
+	bool open(std::span<const uint8_t> data);
+
+	/// Reads the next frame
+	/// \return true on success, false at the end of the file or on error;
+	/// a frame with more than getMaxBodyCount() bodies is an error
+	bool readFrame(TrajectoryFrame& frame);
+
+	/// Checks if all frames have been read without errors
+	[[nodiscard]] bool isAtEnd() const noexcept
+	{
+		return mIsAtEnd;
+	}
+
+private:
+	/// Reads the header after opening
+	/// \return true on success
+	bool readHeader();
+
+	/// Reads bytes from the file or the memory
+	/// \return the number of bytes read
+	size_t readBytes(void* data, size_t size);
+
+	/// Reads a frame payload; the result is valid until the next read
+	/// \return true on success
+	bool readPayload(size_t size, std::span<const uint8_t>& payload);
+
+	/// Maximum number of bodies of a frame
+	uint32_t mMaxBodyCount;
+
+	/// File
+	std::ifstream mFile;
+
+	/// Trajectory in memory, empty when reading from the file
+	std::span<const uint8_t> mData;
+
+	/// Read position in the memory
+	size_t mDataPosition{ 0 };
+
+	/// End of file flag
+	bool mIsAtEnd{ false };
+
+	/// Transform words of the previous frame
+	std::vector<uint32_t> mPreviousWords;
+
+	/// Byte planes of the current frame
+	std::vector<uint8_t> mPlanes;
+
+	/// Payload of the current frame
+	std::vector<uint8_t> mPayload;
+};
+
+/// Writes a trajectory in the text format of the regression test results
+/// \return true if all frames were read and written
+bool convertTrajectoryToText(TrajectoryReader& reader, std::ostream& output);
+
+} // namespace nph
@@ -0,0 +1,104 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "TrajectoryComparison.h"
+#include <cmath>
+#include <numbers>
+
+namespace nph
+{
+
+TrajectoryComparison compareTrajectories(
+	TrajectoryReader& reference,
+	TrajectoryReader& actual,
+	const ComparisonTolerances& tolerances,
+	uint32_t lastStep)
+{
+	TrajectoryComparison result;
+	TrajectoryFrame referenceFrame;
+	TrajectoryFrame actualFrame;
+
+	for (;;)
+	{
+		const bool hasReferenceFrame = reference.readFrame(referenceFrame);
+		const bool hasActualFrame = actual.readFrame(actualFrame);
+		if (!hasReferenceFrame || !hasActualFrame)
+		{
+			if ((!hasReferenceFrame && !reference.isAtEnd()) ||
+				(!hasActualFrame && !actual.isAtEnd()))
+			{
+				result.error = "Failed to read a frame.";
+			}
+			else if (hasReferenceFrame || hasActualFrame)
+			{
+				result.error = "Different number of frames.";
+			}
+			break;
+		}
+
+		if (referenceFrame.step != actualFrame.step ||
+			referenceFrame.transforms.size() != actualFrame.transforms.size())
+		{
+			result.error =
+				"Frame " + std::to_string(result.frameCount) +
+				": different steps or body counts.";
+			break;
+		}
+
+		if (referenceFrame.step > lastStep)
+		{
+			break;
+		}
+
+		const uint32_t bodyCount =
+			static_cast<uint32_t>(referenceFrame.transforms.size());
+		if (result.bodies.size() < bodyCount)
+		{
+			result.bodies.resize(bodyCount);
+		}
+
+		StepErrors& stepErrors = result.steps.emplace_back();
+		stepErrors.step = referenceFrame.step;
+
+		for (uint32_t i = 0; i < bodyCount; ++i)
+		{
+			const BodyTransform& expected = referenceFrame.transforms[i];
+			const BodyTransform& got = actualFrame.transforms[i];
+
+			const double positionError = std::hypot(
+				static_cast<double>(got.position.x) - static_cast<double>(expected.position.x),
+				static_cast<double>(got.position.y) - static_cast<double>(expected.position.y));
+
+			// The angles are not normalized, so compare them modulo 2 * pi
+			const double rotationError = std::abs(std::remainder(
+				static_cast<double>(got.angle) - static_cast<double>(expected.angle),
+				2.0 * std::numbers::pi));
+
+			stepErrors.errors.position.add(positionError);
+			stepErrors.errors.rotation.add(rotationError);
+			result.bodies[i].position.add(positionError);
+			result.bodies[i].rotation.add(rotationError);
+
+			// NaN errors are divergent too
+			if (!result.hasDivergence &&
+				!(positionError <= tolerances.position &&
+				rotationError <= tolerances.rotation))
+			{
+				result.hasDivergence = true;
+				result.divergentStep = referenceFrame.step;
+				result.divergentBody = i;
+			}
+		}
+
+		result.total.position.add(stepErrors.errors.position);
+		result.total.rotation.add(stepErrors.errors.rotation);
+
+		++result.frameCount;
+		result.bodyStepCount += bodyCount;
+	}
+	return result;
+}
+
+} // namespace nph
@@ -0,0 +1,130 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+#include "Trajectory.h"
+
+namespace nph
+{
+
+/// Tolerances of the trajectory comparison
+struct ComparisonTolerances
+{
+	/// Maximum distance between the body positions
+	float position{ 1.0e-4f };
+
+	/// Maximum difference of the body angles in radians
+	float rotation{ 1.0e-4f };
+};
+
+/// Statistics of error values
+struct ErrorStatistics
+{
+	/// Maximum error
+	double max{ 0.0 };
+
+	/// Sum of the errors
+	double sum{ 0.0 };
+
+	/// Number of the errors
+	uint64_t count{ 0 };
+
+	/// Adds an error
+	void add(double error) noexcept
+	{
+		max = std::max(max, error);
+		sum += error;
+		++count;
+	}
+
+	/// Adds the errors of other statistics
+	void add(const ErrorStatistics& other) noexcept
+	{
+		max = std::max(max, other.max);
+		sum += other.sum;
+		count += other.count;
+	}
+
+	/// Returns the mean error
+	[[nodiscard]] double getMean() const noexcept
+	{
+		return count == 0 ? 0.0 : sum / static_cast<double>(count);
+	}
+};
+
+/// Position and rotation error statistics
+struct TrajectoryErrors
+{
+	/// Position errors
+	ErrorStatistics position;
+
+	/// Rotation errors
+	ErrorStatistics rotation;
+};
+
+/// Errors of a trajectory frame
+struct StepErrors
+{
+	/// Simulation step
+	uint32_t step;
+
+	/// Errors of the bodies at the step
+	TrajectoryErrors errors;
+};
+
+/// Result of a trajectory comparison
+struct TrajectoryComparison
+{
+	/// Error message if the trajectories could not be compared,
+	/// e.g. on a read error or different frame steps; empty otherwise
+	std::string error;
+
+	/// Number of compared frames
+	uint32_t frameCount{ 0 };
+
+	/// Number of compared body states
+	uint64_t bodyStepCount{ 0 };
+
+	/// Errors of all bodies at all steps
+	TrajectoryErrors total;
+
+	/// Errors of each body, indexed by body index
+	std::vector<TrajectoryErrors> bodies;
+
+	/// Errors of each frame
+	std::vector<StepErrors> steps;
+
+	/// Flag of an error above the tolerances
+	bool hasDivergence{ false };
+
+	/// First step with an error above the tolerances
+	uint32_t divergentStep{ 0 };
+
+	/// Body with the first error above the tolerances
+	uint32_t divergentBody{ 0 };
+
+	/// Checks if the trajectories match within the tolerances
+	[[nodiscard]] bool isPassed() const noexcept
+	{
+		return error.empty() && !hasDivergence;
+	}
+};
+
+/// Compares two trajectories frame by frame; the frames must have
+/// the same steps and body counts
+/// \param lastStep The frames after this step are not compared,
+/// e.g. after a chaotic pile diverges from the small initial differences
+TrajectoryComparison compareTrajectories(
+	TrajectoryReader& reference,
+	TrajectoryReader& actual,
+	const ComparisonTolerances& tolerances,
+	uint32_t lastStep = std::numeric_limits<uint32_t>::max());
+
+} // namespace nph
@@ -337,10 +337,10 @@ void drawArrow(
 }
 
 /// Draws a body
-void drawBody(const Body& body)
+void drawBody(const Body& body, const BodyTransform& transform)
 {
-	const Mat22& rot = body.rotation.getMat();
-	const Vec2& pos = body.position;
+	const Mat22 rot = rotationMat(transform.angle);
+	const Vec2& pos = transform.position;
 	const Vec2& hs = body.halfSize;
 
 	const Vec2 v1 = pos + rot * Vec2(-hs.x, -hs.y);
@@ -410,12 +410,12 @@ void drawContacts(const World& world, float pointSize)
 
 		for (uint32_t i = 0; i < manifold.getContactCount(); ++i)
 		{
-			const CollisionPoint& point = manifold.getContact(i).getPoint();
+			const auto& localPoints = manifold.getContact(i).getLocalPoints();
 			const Vec2 point1 =
-				bodyA.position + bodyA.rotation.getMat() * point.localPoints[0];
+				bodyA.position + bodyA.rotation.getMat() * localPoints[0];
 
 			const Vec2 point2 =
-				bodyB.position + bodyB.rotation.getMat() * point.localPoints[1];
+				bodyB.position + bodyB.rotation.getMat() * localPoints[1];
 
 			// Draw contact point on body A
 			glVertex2f(point1.x, point1.y);
@@ -559,14 +559,18 @@ void Visualization::drawWorld(
 		}
 	}
 
-	for (const Body& body : world.getBodies())
+	// The bodies are drawn between the last two steps of World::advance
+	const Real alpha = world.getInterpolationAlpha();
+	for (uint32_t i = 0; i < world.getBodies().size(); ++i)
 	{
-		drawBody(body);
+		const Body& body = world.getBodies()[i];
+		const BodyTransform transform = world.getInterpolatedTransform(i, alpha);
+		drawBody(body, transform);
 		if (settings.bodyVelocities)
 		{
 			drawArrow(
-				body.position,
-				body.position + body.linearVelocity,
+				transform.position,
+				transform.position + body.linearVelocity,
 				settings.bodyVelocityArrowSize,
 				{ 1.0f, 0.0f, 1.0f });
 		}
@@ -574,8 +578,8 @@ void Visualization::drawWorld(
 		if (settings.bodyFrames)
 		{
 			drawFrame(
-				body.position,
-				body.rotation.getMat(),
+				transform.position,
+				rotationMat(transform.angle),
 				settings.bodyFrameSize);
 		}
 	}
@@ -0,0 +1,38 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cstdint>
+#include "neat_physics/math/Real.h"
+
+namespace nph
+{
+
+/// Settings of the adaptive substepping, see World::doStep
+/// A step is subdivided if the bodies move too far relative to their sizes
+/// or if the previous step ended with a deep penetration or a large
+/// velocity error of the contacts; calm steps are not subdivided
+struct AdaptiveStepSettings
+{
+	/// Flag of the adaptive substepping, disabled by default
+	bool enabled{ false };
+
+	/// Maximum number of substeps per step; must be > 0
+	uint32_t maxSubsteps{ 8 };
+
+	/// Maximum motion of a body point per substep relative to
+	/// the smaller half size of the body; must be > 0
+	Real maxMotionRatio{ 0.5f };
+
+	/// Maximum contact penetration after a step; must be > 0
+	Real maxPenetration{ 0.01f };
+
+	/// Maximum error of the contact velocities after the velocity
+	/// iterations, see ContactSolver::getMaxVelocityError; must be > 0
+	Real maxVelocityError{ 0.1f };
+};
+
+} // namespace nph
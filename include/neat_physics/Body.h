@@ -21,19 +21,19 @@ struct Body
 	const Vec2 halfSize;
 
 	/// Mass (0 if static)
-	const float mass;
+	const Real mass;
 
 	/// Inverse mass (0 if static)
-	const float invMass;
+	const Real invMass;
 
 	/// Moment of inertia (0 if static)
-	const float inertia;
+	const Real inertia;
 
 	/// Inverse moment of inertia (0 if static)
-	const float invInertia;
+	const Real invInertia;
 
 	/// Friction coefficient [0, 1]
-	const float friction;
+	const Real friction;
 
 	/// Position
 	Vec2 position{ 0.0f, 0.0f };
@@ -45,7 +45,12 @@ struct Body
 	Vec2 linearVelocity{ 0.0f, 0.0f };
 
 	/// Angular velocity
-	float angularVelocity{ 0.0f };
+	Real angularVelocity{ 0.0f };
+
+	/// Flag of a fast body swept against the static bodies and the other
+	/// bullets during a step, so it does not tunnel through thin bodies,
+	/// see World::doStep
+	bool isBullet{ false };
 
 	/// Constructor
 	/// \param inSize Body size; must be > 0 in both dimensions
@@ -53,8 +58,8 @@ struct Body
 	/// \param inFriction Friction coefficient; must be in range [0, 1]
 	Body(
 		const Vec2& inSize,
-		float inMass,
-		float inFriction);
+		Real inMass,
+		Real inFriction);
 
 	/// Checks if the body is static
 	[[nodiscard]] bool isStatic() const noexcept
@@ -66,5 +71,15 @@ struct Body
 /// Body array type
 using BodyArray = std::vector<Body>;
 
+/// Body transform: position and rotation angle
+struct BodyTransform
+{
+	/// Position
+	Vec2 position;
+
+	/// Rotation angle in radians
+	Real angle;
+};
+
 // namespace nph
 }
@@ -0,0 +1,76 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cfloat>
+
+/// Scalar types of the engine, see NPH_SCALAR
+#define NPH_SCALAR_FLOAT 0
+#define NPH_SCALAR_DOUBLE 1
+#define NPH_SCALAR_FIXED32 2
+#define NPH_SCALAR_FIXED64 3
+
+/// Scalar type used for all engine quantities (nph::Real)
+/// - NPH_SCALAR_FLOAT: IEEE 754 single precision, for dense scenes
+/// - NPH_SCALAR_DOUBLE: IEEE 754 double precision, for large worlds
+///   where float loses precision far from the origin
+/// - NPH_SCALAR_FIXED32: 16.16 fixed point, bit-exact on any platform
+/// - NPH_SCALAR_FIXED64: 32.32 fixed point, bit-exact on any platform
+/// Like NPH_DETERMINISTIC, the macro must have the same value in the engine
+/// and in all code using it; a separate engine library is built per value.
+#ifndef NPH_SCALAR
+#define NPH_SCALAR NPH_SCALAR_FLOAT
+#endif
+
+#if NPH_SCALAR != NPH_SCALAR_FLOAT && \
+	NPH_SCALAR != NPH_SCALAR_DOUBLE && \
+	NPH_SCALAR != NPH_SCALAR_FIXED32 && \
+	NPH_SCALAR != NPH_SCALAR_FIXED64
+#error "Unknown NPH_SCALAR value"
+#endif
+
+/// Whether the scalar type is a fixed-point one
+#define NPH_FIXED_POINT \
+	(NPH_SCALAR == NPH_SCALAR_FIXED32 || NPH_SCALAR == NPH_SCALAR_FIXED64)
+
+/// Polynomial sine and cosine
+/// When defined to 1 (default), the float engine computes the rotations
+/// with fastSinCos instead of std::sin and std::cos; defined to 0, e.g. to
+/// record a reference trajectory for the regression test. Like NPH_SCALAR,
+/// the macro must have the same value in the engine and in all code using it.
+#ifndef NPH_FAST_SIN_COS
+#define NPH_FAST_SIN_COS 1
+#endif
+
+/// Deterministic math mode
+/// When defined to 1, the engine produces bit-exact results across compilers
+/// and platforms with IEEE 754 arithmetic: it uses its own portable sin / cos,
+/// a hardware square root and disables contraction of float expressions
+/// into FMA instructions in the code including the engine headers.
+/// The macro must have the same value in the engine and in all code using it,
+/// e.g. set it in the preprocessor definitions of the projects.
+/// \note With GCC, also compile with -ffp-contract=off, since the GCC
+/// optimize pragma below is not guaranteed to be respected
+#ifndef NPH_DETERMINISTIC
+#define NPH_DETERMINISTIC 0
+#endif
+
+#if NPH_DETERMINISTIC
+
+// Intermediate float results must not be kept in a higher precision (e.g. x87)
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+#error "NPH_DETERMINISTIC requires FLT_EVAL_METHOD == 0 (e.g. SSE2 instead of x87)"
+#endif
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include "neat_physics/math/Real.h"
+
+namespace nph
+{
+
+/// Settings of the reuse of the prepared contact data across steps,
+/// see World::setContactReuseSettings
+/// The contacts of a manifold keep the normal, the offsets and the effective
+/// masses of the last preparation while both bodies stay within
+/// the thresholds from their poses at that preparation; only the warm
+/// starting impulses are applied again. Suits the resting contacts.
+struct ContactReuseSettings
+{
+	/// Flag of the reuse, disabled by default
+	bool enabled{ false };
+
+	/// Maximum displacement of a body since the last preparation; must be >= 0
+	Real maxDistance{ 0.001f };
+
+	/// Maximum rotation of a body in radians since the last preparation;
+	/// must be >= 0
+	Real maxAngle{ 0.002f };
+};
+
+} // namespace nph
@@ -0,0 +1,48 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cstdint>
+
+namespace nph
+{
+
+/// Instruction sets of the engine kernels (sweep-and-prune active set test,
+/// box-box separating axis test, integration), see World::setKernelIsa
+/// The values match the NPH_SIMD_ISA values of the wide types.
+/// The kernels of all instruction sets produce the same results:
+/// the kernel source files disable the contraction of float expressions
+/// into FMA, so a variant can be chosen per machine.
+enum class KernelIsa : uint32_t
+{
+	/// Plain C++, available on all platforms and scalar types
+	SCALAR = 0,
+
+	/// SSE2, 4 lanes
+	SSE2 = 1,
+
+	/// AVX2, 8 lanes
+	AVX2 = 2,
+
+	/// AVX-512 (AVX512F), 16 lanes
+	AVX512 = 3,
+
+	/// NEON (AArch64), 4 lanes
+	NEON = 4
+};
+
+/// Returns the name of an instruction set, e.g. "AVX2"
+[[nodiscard]] const char* getKernelIsaName(KernelIsa isa) noexcept;
+
+/// Checks if the kernels for an instruction set are built into the engine
+/// and supported by the CPU and the OS
+/// \note The vectorized kernels require NPH_SCALAR_FLOAT
+[[nodiscard]] bool isKernelIsaSupported(KernelIsa isa) noexcept;
+
+/// Returns the widest supported instruction set, detected once via CPUID
+[[nodiscard]] KernelIsa getBestKernelIsa() noexcept;
+
+} // namespace nph
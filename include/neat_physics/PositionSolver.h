@@ -0,0 +1,31 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cstdint>
+
+namespace nph
+{
+
+/// Solvers of the contact positions (penetration), see World::setPositionSolver
+enum class PositionSolver : uint32_t
+{
+	/// Position based dynamics: each contact of each iteration is
+	/// transformed for the current body poses and moves the bodies directly,
+	/// updating their rotations
+	PBD = 0,
+
+	/// Pseudo velocities (split impulses): each contact is transformed
+	/// once, the iterations solve the penetrations linearized around
+	/// the poses at the start and accumulate the corrections of the bodies,
+	/// which are applied to the poses once after the iterations.
+	/// Avoids the trigonometry and the transforms of the iterations,
+	/// but the normals and the contact offsets do not follow the rotations
+	/// of the corrections.
+	PSEUDO_VELOCITIES = 1
+};
+
+} // namespace nph
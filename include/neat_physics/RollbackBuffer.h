@@ -0,0 +1,130 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <vector>
+#include "neat_physics/Body.h"
+#include "neat_physics/collision/BroadPhase.h"
+#include "neat_physics/dynamics/ContactSolver.h"
+
+namespace nph
+{
+
+/// Ring buffer of world states for rewinding and resimulation
+/// Each state stores only what the simulation does not recompute:
+/// the dynamic body states, the broad-phase ordering and the persistent
+/// contact manifolds. Restoring a state and stepping again reproduces
+/// the original simulation bit-exactly.
+class RollbackBuffer
+{
+public:
+	/// Constructor
+	/// \param capacity The maximum number of stored states, 0 disables the buffer
+	/// \param keyframeInterval Every keyframeInterval-th state stores all
+	/// dynamic bodies, the other ones store only the bodies changed since
+	/// the previous state (delta encoding); asserted to be > 0
+	RollbackBuffer(
+		uint32_t capacity = 0,
+		uint32_t keyframeInterval = 1);
+
+	/// Returns the maximum number of stored states
+	[[nodiscard]] uint32_t getCapacity() const noexcept
+	{
+		return static_cast<uint32_t>(mStates.size());
+	}
+
+	/// Returns the keyframe interval
+	[[nodiscard]] uint32_t getKeyframeInterval() const noexcept
+	{
+		return mKeyframeInterval;
+	}
+
+	/// Returns the maximum number of steps that can be rewound
+	[[nodiscard]] uint32_t getMaxStepsBack() const noexcept;
+
+	/// Returns the memory allocated for the stored states in bytes
+	[[nodiscard]] size_t getMemoryUsage() const noexcept;
+
+	/// Removes all stored states
+	void clear() noexcept;
+
+	/// Stores the current state, overwriting the oldest one if the buffer is full
+	void save(
+		const BodyArray& bodies,
+		const BroadPhase& broadPhase,
+		const ContactSolver& contactSolver);
+
+	/// Restores the state stored stepsBack saves ago and removes the newer states
+	/// \return true on success, false if the state is not available
+	bool restore(
+		uint32_t stepsBack,
+		BodyArray& bodies,
+		BroadPhase& broadPhase,
+		ContactSolver& contactSolver);
+
+private:
+	/// State of a dynamic body
+	struct BodyState
+	{
+		/// Position
+		Vec2 position;
+
+		/// Rotation angle; the rotation matrix is recomputed from it
+		Real angle;
+
+		/// Linear velocity
+		Vec2 linearVelocity;
+
+		/// Angular velocity
+		Real angularVelocity;
+
+		/// Bitwise comparison operator, used for the delta encoding
+		[[nodiscard]] bool operator==(const BodyState& other) const noexcept;
+	};
+
+	/// Stored world state
+	struct State
+	{
+		/// Number of bodies
+		uint32_t bodyCount;
+
+		/// Keyframe flag: bodyStates contain all dynamic bodies in order,
+		/// otherwise only the bodies listed in changedBodies
+		bool isKeyframe;
+
+		/// Indices of the bodies changed since the previous state
+		std::vector<uint32_t> changedBodies;
+
+		/// Body states
+		std::vector<BodyState> bodyStates;
+
+		/// Broad-phase endpoints
+		BroadPhase::EndpointArray endpoints;
+
+		/// Persistent contact manifolds
+		ContactSolver::ManifoldRecordArray manifolds;
+	};
+
+	/// Returns the ring index of the state stored stepsBack saves ago
+	[[nodiscard]] uint32_t getStateIndex(uint32_t stepsBack) const noexcept;
+
+	/// Stored states (ring buffer)
+	std::vector<State> mStates;
+
+	/// Keyframe interval
+	uint32_t mKeyframeInterval;
+
+	/// Ring index of the newest state
+	uint32_t mNewest{ 0 };
+
+	/// Number of stored states
+	uint32_t mCount{ 0 };
+
+	/// Full body states of the newest state, indexed by body index
+	std::vector<BodyState> mLastBodyStates;
+};
+
+} // namespace nph
@@ -0,0 +1,158 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <span>
+#include <vector>
+#include "neat_physics/Body.h"
+
+namespace nph
+{
+
+// Forward declarations
+class World;
+
+/// Quantized body transform
+struct QuantizedTransform
+{
+	/// Position in the units of the position precision
+	int32_t x;
+	int32_t y;
+
+	/// Angle in the units of 2 * pi / 2^angleBits, in range [0, 2^angleBits)
+	uint32_t angle;
+
+	/// Comparison operator
+	[[nodiscard]] bool operator==(const QuantizedTransform&) const noexcept = default;
+};
+
+/// Quantization of the transforms for the state encoding;
+/// the encoder and the decoder must use the same settings
+struct StateQuantization
+{
+	/// Position precision in world units; asserted to be > 0
+	float positionPrecision{ 1.0f / 1024.0f };
+
+	/// Number of bits of the angle; asserted to be in range [2, 32]
+	uint32_t angleBits{ 16 };
+
+	/// Quantizes a transform; positions outside of the int32_t range are clamped
+	[[nodiscard]] QuantizedTransform quantize(
+		const Vec2& position,
+		Real angle) const noexcept;
+
+	/// Restores a transform from the quantized one;
+	/// the angle is returned in range [0, 2 * pi)
+	[[nodiscard]] BodyTransform dequantize(
+		const QuantizedTransform& transform) const noexcept;
+};
+
+/// Encodes body transforms into a compact byte stream
+/// A packet contains only the bodies whose quantized transforms changed
+/// since the previous packet (the baseline), so the bodies at rest cost
+/// nothing. The changed values are written as zigzag varints of the deltas
+/// from the baseline. The packets must be decoded in order by a decoder
+/// with the same quantization; use one encoder per receiver.
+class StateEncoder
+{
+public:
+	/// Constructor
+	explicit StateEncoder(const StateQuantization& quantization = {});
+
+	/// Returns the quantization
+	[[nodiscard]] const StateQuantization& getQuantization() const noexcept
+	{
+		return mQuantization;
+	}
+
+	/// Appends a packet with the changed bodies to output and updates the baseline
+	/// \return the number of encoded bodies
+	uint32_t encode(const BodyArray& bodies, std::vector<uint8_t>& output);
+
+	/// Resets the baseline: the next packet contains all bodies
+	/// and resets the decoder's state, e.g. after a packet loss
+	void resetBaseline() noexcept;
+
+private:
+	/// Quantization
+	StateQuantization mQuantization;
+
+	/// Quantized transforms of the last encoded packet
+	std::vector<QuantizedTransform> mBaseline;
+
+	/// Flag of the reset baseline
+	bool mIsBaselineReset{ true };
+};
+
+/// Decodes the packets of StateEncoder
+class StateDecoder
+{
+public:
+	/// Default maximum number of bodies of a packet
+	static constexpr uint32_t DEFAULT_MAX_BODY_COUNT = 1u << 20;
+
+	/// Constructor
+	/// \param maxBodyCount The maximum number of bodies of a packet;
+	/// the packets come from the network, so the body count of a packet
+	/// is not trusted to size the decoded state; asserted to be > 0
+	explicit StateDecoder(
+		const StateQuantization& quantization = {},
+		uint32_t maxBodyCount = DEFAULT_MAX_BODY_COUNT);
+
+	/// Returns the quantization
+	[[nodiscard]] const StateQuantization& getQuantization() const noexcept
+	{
+		return mQuantization;
+	}
+
+	/// Returns the maximum number of bodies of a packet
+	[[nodiscard]] uint32_t getMaxBodyCount() const noexcept
+	{
+		return mMaxBodyCount;
+	}
+
+	/// Decodes a packet and updates the transforms
+	/// \return true on success; a malformed packet or a packet with more
+	/// than getMaxBodyCount() bodies is ignored
+	bool decode(std::span<const uint8_t> packet);
+
+	/// Returns the decoded transforms, indexed by body index
+	[[nodiscard]] const std::vector<BodyTransform>& getTransforms() const noexcept
+	{
+		return mTransforms;
+	}
+
+	/// Returns the indices of the bodies changed by the last decoded packet
+	[[nodiscard]] const std::vector<uint32_t>& getChangedBodies() const noexcept
+	{
+		return mChangedBodies;
+	}
+
+	/// Applies the transforms to the bodies of a mirror world
+	/// \return false if the number of bodies does not match
+	bool apply(World& world) const;
+
+private:
+	/// Quantization
+	StateQuantization mQuantization;
+
+	/// Maximum number of bodies of a packet
+	uint32_t mMaxBodyCount;
+
+	/// Quantized transforms
+	std::vector<QuantizedTransform> mQuantized;
+
+	/// Dequantized transforms
+	std::vector<BodyTransform> mTransforms;
+
+	/// Indices of the changed bodies
+	std::vector<uint32_t> mChangedBodies;
+
+	/// Changed transforms of the packet being decoded
+	std::vector<QuantizedTransform> mChangedTransforms;
+};
+
+} // namespace nph
@@ -0,0 +1,35 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cstdint>
+
+namespace nph
+{
+
+/// Compile-time configuration of the simulation step, see World::doStep
+/// Unlike the runtime settings of the world, the values are constant
+/// expressions, so the solver loops have fixed trip counts and
+/// the disabled features are removed from the generated code
+template <
+	uint32_t VelocityIterations,
+	uint32_t PositionIterations,
+	bool Friction = true>
+struct StepConfig
+{
+	static_assert(VelocityIterations > 0, "At least one velocity iteration is required");
+
+	/// Number of velocity iterations
+	static constexpr uint32_t VELOCITY_ITERATIONS = VelocityIterations;
+
+	/// Number of position iterations, 0 disables the position solve
+	static constexpr uint32_t POSITION_ITERATIONS = PositionIterations;
+
+	/// Whether the friction impulses are solved
+	static constexpr bool FRICTION = Friction;
+};
+
+} // namespace nph
@@ -0,0 +1,29 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cstdint>
+
+namespace nph
+{
+
+/// Solvers of the contact velocities, see World::setVelocitySolver
+enum class VelocitySolver : uint32_t
+{
+	/// Sequential impulses (Gauss-Seidel): each manifold sees
+	/// the impulses applied by the previous ones in the same iteration
+	GAUSS_SEIDEL = 0,
+
+	/// Relaxed Jacobi: all manifolds of an iteration read the same
+	/// velocities, then their velocity changes scaled by the relaxation
+	/// (see World::setJacobiRelaxation) are summed in the manifold order.
+	/// The manifolds can be solved in parallel or in SIMD lanes
+	/// without a graph coloring, and the result does not depend
+	/// on the manifold order of the solving.
+	JACOBI = 1
+};
+
+} // namespace nph
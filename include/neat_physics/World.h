@@ -4,18 +4,32 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <vector>
+#include "neat_physics/AdaptiveStepSettings.h"
+#include "neat_physics/ContactReuseSettings.h"
 #include "neat_physics/Body.h"
+#include "neat_physics/RollbackBuffer.h"
+#include "neat_physics/StepConfig.h"
+#include "neat_physics/PositionSolver.h"
+#include "neat_physics/VelocitySolver.h"
+#include "neat_physics/WorldStats.h"
 #include "neat_physics/collision/CollisionSystem.h"
 #include "neat_physics/dynamics/ContactSolver.h"
 
 namespace nph
 {
 
+// Forward declarations
+class WorldSnapshotView;
+
 /// Physics world
 class World
 {
 public:
+	/// Maximum number of the continuous collision substeps of a bullet per step
+	static constexpr uint32_t MAX_CONTINUOUS_SUBSTEPS = 8;
+
 	/// Constructor
 	/// \param maxBodies Maximum number of bodies in the world; asserted to be > 0
 	/// \param gravity Gravity vector applied to all bodies
@@ -47,21 +61,331 @@ public:
 		return mContactSolver;
 	}
 
+	/// Returns the statistics of the world
+	[[nodiscard]] const WorldStats& getStats() const noexcept
+	{
+		return mStats;
+	}
+
+	/// Returns the instruction set of the kernels;
+	/// the best supported one is selected on construction
+	[[nodiscard]] KernelIsa getKernelIsa() const noexcept
+	{
+		return mStats.kernelIsa;
+	}
+
+	/// Overrides the instruction set of the kernels, e.g. for testing;
+	/// all instruction sets produce the same results
+	/// \return true on success, false if the instruction set is not supported
+	bool setKernelIsa(KernelIsa isa) noexcept;
+
 	/// Adds a body to the world
 	/// \return the added body or nullptr if the body could not be added
 	/// (e.g., when the number of bodies == uint32_t max value)
 	Body* addBody(
 		const Vec2& size,
-		float mass,
-		float friction,
+		Real mass,
+		Real friction,
 		const Vec2& position = {0.0f, 0.0f},
-		float rotationRad = 0.0f);
+		Real rotationRad = 0.0f);
+
+	/// Sets the position and rotation of a body, e.g. to mirror a remote world
+	/// \param bodyIndex Index of the body; asserted to be valid
+	void setBodyTransform(
+		uint32_t bodyIndex,
+		const Vec2& position,
+		Real rotationRad);
 
 	/// Clear the world: remove all bodies
 	void clear() noexcept;
 
 	/// Perform one simulation step
-	void doStep(float dt);
+	/// If the adaptive substepping is enabled, the step is divided into
+	/// equal substeps, see AdaptiveStepSettings and WorldStats::substepCount.
+	/// The bullet bodies are swept from their poses at the start of the step
+	/// to the end poses against the static bodies and the other bullets found
+	/// by the broad phase and, on an impact, are substepped up to
+	/// MAX_CONTINUOUS_SUBSTEPS times; the other bodies are taken
+	/// at their end poses
+	void doStep(Real dt);
+
+	/// Advances the world by a real time interval, e.g. the frame time,
+	/// with fixed steps of getFixedTimeStep(); the time left after the last
+	/// step is accumulated for the next call, see getInterpolationAlpha.
+	/// At most getMaxStepsPerAdvance() steps are done, the rest of the time
+	/// is dropped, so a slow step does not make the next calls ever slower.
+	/// \return the number of the steps done
+	uint32_t advance(Real realTime);
+
+	/// Returns the time step of advance
+	[[nodiscard]] Real getFixedTimeStep() const noexcept
+	{
+		return mFixedTimeStep;
+	}
+
+	/// Sets the time step of advance; asserts that the step is > 0
+	void setFixedTimeStep(Real timeStep) noexcept
+	{
+		assert(timeStep > 0.0f);
+		mFixedTimeStep = timeStep;
+	}
+
+	/// Returns the maximum number of steps of a call of advance
+	[[nodiscard]] uint32_t getMaxStepsPerAdvance() const noexcept
+	{
+		return mMaxStepsPerAdvance;
+	}
+
+	/// Sets the maximum number of steps of a call of advance;
+	/// asserts that the number is > 0
+	void setMaxStepsPerAdvance(uint32_t maxSteps) noexcept
+	{
+		assert(maxSteps > 0);
+		mMaxStepsPerAdvance = maxSteps;
+	}
+
+	/// Returns the fraction of the fixed step accumulated by advance
+	/// after the last step, in [0, 1): the position of the real time
+	/// between the last two steps
+	[[nodiscard]] Real getInterpolationAlpha() const noexcept
+	{
+		return mAccumulatedTime / mFixedTimeStep;
+	}
+
+	/// Returns the transform of a body interpolated between the poses before
+	/// and after the last step of advance, e.g. for smooth rendering when
+	/// the rendering and the physics rates differ; the bodies not stepped
+	/// by advance yet are returned at their current poses
+	/// \param bodyIndex Index of the body; asserted to be valid
+	/// \param alpha Interpolation factor, 0 for the previous pose,
+	/// 1 for the current one, see getInterpolationAlpha
+	[[nodiscard]] BodyTransform getInterpolatedTransform(
+		uint32_t bodyIndex,
+		Real alpha) const noexcept;
+
+	/// Performs one simulation step with a compile-time configuration:
+	/// Gauss-Seidel velocity iterations and PBD position iterations
+	/// with the counts of Config instead of the ones of the world.
+	/// The collision detection, the speculative contacts, the contact reuse
+	/// (see setContactReuseSettings) and the continuous collisions
+	/// of the bullets are applied as by doStep(Real).
+	/// The following settings are not used; debug builds assert
+	/// that they are left at their defaults:
+	/// - the velocity solver, see setVelocitySolver
+	/// - the position solver, see setPositionSolver
+	/// - the shock propagation, see setShockPropagationIterations
+	/// - the direct solve, see setDirectSolveMaxConstraints
+	/// - the adaptive substepping, see setAdaptiveStepSettings
+	/// \tparam Config The step configuration, see StepConfig
+	template <typename Config>
+	void doStep(Real dt)
+	{
+		assert(mVelocitySolver == VelocitySolver::GAUSS_SEIDEL);
+		assert(mPositionSolver == PositionSolver::PBD);
+		assert(mShockPropagationIterations == 0);
+		assert(mDirectSolveMaxConstraints == 0);
+		assert(!mAdaptiveStepSettings.enabled);
+
+		prepareStep(dt, VelocitySolver::GAUSS_SEIDEL);
+		mContactSolver.solveVelocities<Config::VELOCITY_ITERATIONS, Config::FRICTION>();
+		integratePositions(dt);
+		if constexpr (Config::POSITION_ITERATIONS > 0)
+		{
+			mContactSolver.solvePositions<Config::POSITION_ITERATIONS>();
+		}
+		solveContinuousCollisions(dt);
+		finishStep();
+	}
+
+	/// Writes the world state to a versioned binary snapshot:
+	/// settings, bodies, broad-phase endpoints sorted for the current
+	/// body poses and persistent contact manifolds including
+	/// the warm starting impulses
+	/// \see WorldSnapshotHeader for the layout
+	/// \return true on success
+	bool saveSnapshot(std::ostream& stream) const;
+
+	/// Replaces the world state with a snapshot written by saveSnapshot;
+	/// the snapshot is read with a single bulk read from a seekable stream
+	/// holding the whole snapshot, otherwise in bounded chunks
+	/// \note The snapshot uses the native memory layout, so it can be loaded
+	/// only by a build with the same layout of the bodies and contacts
+	/// \return true on success; on failure the world is cleared
+	bool loadSnapshot(std::istream& stream);
+
+	/// Replaces the world state with a snapshot stored in memory,
+	/// e.g. in a memory-mapped file
+	/// \return true on success; on failure the world is cleared
+	bool loadSnapshot(const WorldSnapshotView& snapshot);
+
+	/// Enables recording of the world state after each step for rewinding;
+	/// the current state is recorded immediately
+	/// \param capacity The maximum number of recorded states, 0 disables recording
+	/// \param keyframeInterval The interval of the full states, see RollbackBuffer
+	void setRollbackCapacity(
+		uint32_t capacity,
+		uint32_t keyframeInterval = 1);
+
+	/// Returns the buffer of the recorded states
+	[[nodiscard]] const RollbackBuffer& getRollbackBuffer() const noexcept
+	{
+		return mRollback;
+	}
+
+	/// Rewinds the world to the state recorded stepsBack steps ago;
+	/// the newer states are discarded
+	/// \return true on success, false if the state is not recorded
+	bool rewind(uint32_t stepsBack);
+
+	/// Returns the hash of the bit-exact world state for desync detection:
+	/// the states of all bodies and, if enabled, the persistent contacts
+	/// The hash is maintained after each step and on each change of the bodies
+	[[nodiscard]] uint64_t getStateHash() const noexcept
+	{
+		return mStateHash;
+	}
+
+	/// Returns if the persistent contacts are included into the state hash
+	[[nodiscard]] bool isContactHashEnabled() const noexcept
+	{
+		return mContactHashEnabled;
+	}
+
+	/// Includes the persistent contacts (body pairs, features and impulses)
+	/// into the state hash; costs an additional pass over the contacts per step
+	void setContactHashEnabled(bool enabled);
+
+	/// Returns if the speculative contacts are enabled
+	[[nodiscard]] bool isSpeculativeContactsEnabled() const noexcept
+	{
+		return mSpeculativeContactsEnabled;
+	}
+
+	/// Enables the speculative contacts against tunnelling of fast bodies:
+	/// the AABBs are swept along the velocities over the time step, and
+	/// separated but approaching boxes get contacts which let them
+	/// approach exactly by the gap during the step. Disabled by default.
+	void setSpeculativeContactsEnabled(bool enabled) noexcept
+	{
+		mSpeculativeContactsEnabled = enabled;
+	}
+
+	/// Returns the settings of the adaptive substepping
+	[[nodiscard]] const AdaptiveStepSettings& getAdaptiveStepSettings() const noexcept
+	{
+		return mAdaptiveStepSettings;
+	}
+
+	/// Sets the settings of the adaptive substepping;
+	/// asserts that the limits are > 0
+	void setAdaptiveStepSettings(const AdaptiveStepSettings& settings) noexcept;
+
+	/// Returns the number of the final solver iterations with the shock propagation
+	[[nodiscard]] uint32_t getShockPropagationIterations() const noexcept
+	{
+		return mShockPropagationIterations;
+	}
+
+	/// Sets the number of the final velocity iterations propagating
+	/// the shocks upwards along the gravity, which makes tall stacks converge
+	/// with fewer iterations; 0 (default) disables it. The lower bodies
+	/// ignore the upper ones in these iterations, and without enough regular
+	/// iterations the pile gains energy, so at most half of the velocity
+	/// iterations propagate the shocks and the excess is ignored:
+	/// e.g. 2 of 5 keeps the 100-row glass of the regression test nearly
+	/// as tall as 15 regular iterations do
+	/// \see ContactSolver::solveVelocitiesWithShock
+	void setShockPropagationIterations(uint32_t iterations) noexcept
+	{
+		mShockPropagationIterations = iterations;
+	}
+
+	/// Returns the solver of the contact velocities
+	[[nodiscard]] VelocitySolver getVelocitySolver() const noexcept
+	{
+		return mVelocitySolver;
+	}
+
+	/// Sets the solver of the contact velocities, Gauss-Seidel by default
+	void setVelocitySolver(VelocitySolver solver) noexcept
+	{
+		mVelocitySolver = solver;
+	}
+
+	/// Returns the solver of the contact positions
+	[[nodiscard]] PositionSolver getPositionSolver() const noexcept
+	{
+		return mPositionSolver;
+	}
+
+	/// Sets the solver of the contact positions, PBD by default
+	void setPositionSolver(PositionSolver solver) noexcept
+	{
+		mPositionSolver = solver;
+	}
+
+	/// Returns the relaxation of the Jacobi velocity solver
+	[[nodiscard]] Real getJacobiRelaxation() const noexcept
+	{
+		return mJacobiRelaxation;
+	}
+
+	/// Sets the relaxation of the Jacobi velocity solver: the scale
+	/// of the velocity changes of the manifolds summed in an iteration;
+	/// asserts that the relaxation is in (0, 1]
+	/// \see VelocitySolver::JACOBI
+	void setJacobiRelaxation(Real relaxation) noexcept
+	{
+		assert(0.0f < relaxation && relaxation <= 1.0f);
+		mJacobiRelaxation = relaxation;
+	}
+
+	/// Returns the settings of the reuse of the prepared contact data
+	[[nodiscard]] const ContactReuseSettings& getContactReuseSettings() const noexcept
+	{
+		return mContactReuseSettings;
+	}
+
+	/// Sets the settings of the reuse of the prepared contact data,
+	/// see WorldStats::reusedContactCount for the hit rate;
+	/// asserts that the thresholds are >= 0
+	/// \note The reuse state is not stored in snapshots and rollback
+	/// states, so with the reuse enabled a resimulation after a restore
+	/// is not bit-exact
+	void setContactReuseSettings(const ContactReuseSettings& settings) noexcept
+	{
+		assert(settings.maxDistance >= 0.0f);
+		assert(settings.maxAngle >= 0.0f);
+		mContactReuseSettings = settings;
+	}
+
+	/// Returns the maximum number of constraints of an island
+	/// solved with the direct solver
+	[[nodiscard]] uint32_t getDirectSolveMaxConstraints() const noexcept
+	{
+		return mDirectSolveMaxConstraints;
+	}
+
+	/// Sets the maximum number of constraints (2 per contact point) of an island
+	/// solved to convergence with the direct solver instead of the Gauss-Seidel
+	/// iterations, e.g. 8 for a box resting on another box on the ground;
+	/// 0 (default) disables the direct solver. Used with the Gauss-Seidel
+	/// velocity solver only.
+	/// \see ContactSolver::solveVelocitiesWithDirectSolve
+	void setDirectSolveMaxConstraints(uint32_t maxConstraints) noexcept
+	{
+		mDirectSolveMaxConstraints = maxConstraints;
+	}
+
+	/// Computes the mass ratio of each contact island: the ratio
+	/// of the maximum and the minimum mass of its dynamic bodies,
+	/// which slows down the convergence of the Gauss-Seidel solver;
+	/// for such stacks see setShockPropagationIterations
+	/// and setDirectSolveMaxConstraints
+	void getIslandMassRatios(std::vector<Real>& ratios) const
+	{
+		mContactSolver.getIslandMassRatios(ratios);
+	}
 
 	/// Returns the number of velocity iterations for constraint solvers
 	[[nodiscard]] uint32_t getVelocityIterations() const noexcept
@@ -90,11 +414,44 @@ public:
 	}
 
 private:
+	/// Performs one step without subdivision
+	void doSingleStep(Real timeStep);
+
+	/// Chooses the number of substeps of a step from the body velocities
+	/// and the contact errors after the previous step
+	[[nodiscard]] uint32_t getAdaptiveSubstepCount(Real timeStep) const noexcept;
+
+	/// Performs the step part preceding the solver:
+	/// applies the forces, updates the contacts and prepares the solver
+	void prepareStep(Real timeStep, VelocitySolver velocitySolver);
+
+	/// Solves the contact velocities with the velocity solver of the world
+	void solveVelocities(uint32_t velocityIterations) noexcept;
+
+	/// Solves the contact positions with the position solver of the world
+	void solvePositions(uint32_t positionIterations);
+
+	/// Performs the step part following the solver:
+	/// updates the state hash and records the state for rewinding
+	void finishStep();
+
 	/// Applies forces to all bodies
-	void applyForces(float timeStep);
+	void applyForces(Real timeStep);
 
 	/// Integrates positions of all bodies
-	void integratePositions(float timeStep);
+	/// and records the start poses of the bullets
+	void integratePositions(Real timeStep);
+
+	/// Moves the bullets back to their first impacts during the step
+	/// and solves the impact contacts, see doStep
+	void solveContinuousCollisions(Real timeStep);
+
+	/// Updates the state hash after a step: the static bodies are hashed
+	/// incrementally, the dynamic bodies and the contacts are hashed anew
+	void updateStateHash() noexcept;
+
+	/// Recomputes the state hash including the static bodies
+	void recomputeStateHash() noexcept;
 
 	/// Gravity vector
 	Vec2 mGravity;
@@ -105,14 +462,81 @@ private:
 	/// Number of position iterations for constraint solvers
 	uint32_t mPositionIterations;
 
+	/// Number of the final solver iterations with the shock propagation
+	uint32_t mShockPropagationIterations{ 0 };
+
+	/// Solver of the contact velocities
+	VelocitySolver mVelocitySolver{ VelocitySolver::GAUSS_SEIDEL };
+
+	/// Solver of the contact positions
+	PositionSolver mPositionSolver{ PositionSolver::PBD };
+
+	/// Relaxation of the Jacobi velocity solver
+	Real mJacobiRelaxation{ 0.25f };
+
+	/// Maximum number of constraints of an island solved with the direct solver
+	uint32_t mDirectSolveMaxConstraints{ 0 };
+
+	/// Settings of the reuse of the prepared contact data
+	ContactReuseSettings mContactReuseSettings;
+
+	/// Pose of a bullet at the start of a step
+	struct BulletStart
+	{
+		/// Index of the body
+		uint32_t bodyIndex;
+
+		/// Position
+		Vec2 position;
+
+		/// Rotation angle in radians
+		Real angle;
+	};
+
 	/// Bodies in the world
 	BodyArray mBodies;
 
+	/// Start poses of the bullets in the current step
+	std::vector<BulletStart> mBulletStarts;
+
+	/// Transforms of the bodies before the last step of advance
+	std::vector<BodyTransform> mPreviousTransforms;
+
 	/// Collision system
 	CollisionSystem mCollision;
 
 	/// Contact solver
 	ContactSolver mContactSolver;
+
+	/// Recorded states for rewinding
+	RollbackBuffer mRollback;
+
+	/// Statistics
+	WorldStats mStats;
+
+	/// Sum of the state hashes of the static bodies
+	uint64_t mStaticBodiesHash{ 0 };
+
+	/// World state hash
+	uint64_t mStateHash{ 0 };
+
+	/// Flag of hashing of the contacts
+	bool mContactHashEnabled{ false };
+
+	/// Flag of the speculative contacts
+	bool mSpeculativeContactsEnabled{ false };
+
+	/// Settings of the adaptive substepping
+	AdaptiveStepSettings mAdaptiveStepSettings;
+
+	/// Time step of advance
+	Real mFixedTimeStep{ 1.0f / 60.0f };
+
+	/// Time accumulated by advance and not simulated yet
+	Real mAccumulatedTime{ 0.0f };
+
+	/// Maximum number of steps of a call of advance
+	uint32_t mMaxStepsPerAdvance{ 4 };
 };
 
 } // namespace nph
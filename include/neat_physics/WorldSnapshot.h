@@ -0,0 +1,126 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <array>
+#include <span>
+#include "neat_physics/Body.h"
+#include "neat_physics/collision/BroadPhase.h"
+#include "neat_physics/dynamics/ContactSolver.h"
+
+namespace nph
+{
+
+/// Header of a world snapshot
+/// A snapshot is a single memory block: the header followed by the body,
+/// broad-phase endpoint and contact manifold sections. The sections
+/// store the engine types in their native memory layout and start
+/// at offsets aligned to SECTION_ALIGNMENT, so a memory-mapped snapshot
+/// file can be used in place or loaded with a single bulk read.
+struct WorldSnapshotHeader
+{
+	/// Format identifier
+	static constexpr std::array<char, 4> MAGIC{ 'N', 'P', 'H', 'S' };
+
+	/// Format version, must be incremented on any format change
+	static constexpr uint32_t VERSION = 4;
+
+	/// Alignment of the section offsets in bytes
+	static constexpr uint32_t SECTION_ALIGNMENT = 64;
+
+	/// Format identifier
+	std::array<char, 4> magic;
+
+	/// Format version
+	uint32_t version;
+
+	/// Size of Body in bytes, guards against layout mismatch
+	uint32_t bodySize;
+
+	/// Size of BroadPhase::Endpoint in bytes, guards against layout mismatch
+	uint32_t endpointSize;
+
+	/// Size of ContactSolver::ManifoldRecord in bytes,
+	/// guards against layout mismatch
+	uint32_t manifoldSize;
+
+	/// Scalar type of the engine (NPH_SCALAR), guards against layout mismatch
+	uint32_t scalarType;
+
+	/// Gravity vector
+	Vec2 gravity;
+
+	/// Number of velocity iterations
+	uint32_t velocityIterations;
+
+	/// Number of position iterations
+	uint32_t positionIterations;
+
+	/// Number of bodies
+	uint32_t bodyCount;
+
+	/// Number of broad-phase endpoints, sorted for the stored body poses
+	uint32_t endpointCount;
+
+	/// Number of persistent contact manifolds
+	uint32_t manifoldCount;
+
+	/// Offset of the body section from the snapshot start
+	uint64_t bodiesOffset;
+
+	/// Offset of the endpoint section from the snapshot start
+	uint64_t endpointsOffset;
+
+	/// Offset of the manifold section from the snapshot start
+	uint64_t manifoldsOffset;
+
+	/// Total size of the snapshot in bytes
+	uint64_t totalSize;
+};
+
+/// Read-only view of a world snapshot stored in memory,
+/// e.g. in a memory-mapped file. The data is used in place.
+class WorldSnapshotView
+{
+public:
+	/// Constructor, validates the snapshot
+	/// \param data The snapshot memory; must be aligned to 8 bytes
+	/// and stay alive while the view is used
+	/// \param size The size of the snapshot memory in bytes
+	WorldSnapshotView(const void* data, size_t size) noexcept;
+
+	/// Checks if the snapshot is valid and compatible with this build
+	[[nodiscard]] bool isValid() const noexcept
+	{
+		return mHeader != nullptr;
+	}
+
+	/// Returns the snapshot header; asserts that the snapshot is valid
+	[[nodiscard]] const WorldSnapshotHeader& getHeader() const noexcept
+	{
+		assert(isValid());
+		return *mHeader;
+	}
+
+	/// Returns the bodies; asserts that the snapshot is valid
+	[[nodiscard]] std::span<const Body> getBodies() const noexcept;
+
+	/// Returns the sorted broad-phase endpoints;
+	/// asserts that the snapshot is valid
+	[[nodiscard]] std::span<const BroadPhase::Endpoint>
+		getEndpoints() const noexcept;
+
+	/// Returns the persistent contact manifolds;
+	/// asserts that the snapshot is valid
+	[[nodiscard]] std::span<const ContactSolver::ManifoldRecord>
+		getManifolds() const noexcept;
+
+private:
+	/// Snapshot header or nullptr if the snapshot is invalid
+	const WorldSnapshotHeader* mHeader{ nullptr };
+};
+
+} // namespace nph
@@ -0,0 +1,45 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include "neat_physics/KernelIsa.h"
+#include "neat_physics/math/Real.h"
+
+namespace nph
+{
+
+/// Statistics of a world, see World::getStats
+struct WorldStats
+{
+	/// Instruction set of the active kernels
+	KernelIsa kernelIsa{ KernelIsa::SCALAR };
+
+	/// Number of the continuous collision substeps of the bullets
+	/// in the last step
+	uint32_t continuousSubstepCount{ 0 };
+
+	/// Number of substeps of the last step chosen by the adaptive
+	/// substepping, 1 if it is disabled, see AdaptiveStepSettings
+	uint32_t substepCount{ 1 };
+
+	/// Maximum contact penetration after the last step;
+	/// measured if the adaptive substepping is enabled
+	Real maxPenetration{ 0.0f };
+
+	/// Maximum contact velocity error after the last step;
+	/// measured if the adaptive substepping is enabled
+	Real maxVelocityError{ 0.0f };
+
+	/// Number of the contacts prepared for solving in the last (sub)step
+	uint32_t contactCount{ 0 };
+
+	/// Number of the contacts of the last (sub)step reusing the solver data
+	/// of a previous one, see ContactReuseSettings;
+	/// the hit rate is reusedContactCount / contactCount
+	uint32_t reusedContactCount{ 0 };
+};
+
+} // namespace nph
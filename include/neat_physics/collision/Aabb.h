@@ -32,6 +32,14 @@ struct Aabb
 		assert(min.x <= max.x);
 		assert(min.y <= max.y);
 	}
+
+	/// Checks if the AABB overlaps another one
+	[[nodiscard]] bool overlaps(const Aabb& other) const noexcept
+	{
+		return
+			min.x <= other.max.x && other.min.x <= max.x &&
+			min.y <= other.max.y && other.min.y <= max.y;
+	}
 };
 
 // namespace nph
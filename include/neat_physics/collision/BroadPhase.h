@@ -5,8 +5,10 @@
 #pragma once
 
 // Includes
+#include <span>
 #include <vector>
 #include "neat_physics/Body.h"
+#include "neat_physics/KernelIsa.h"
 #include "neat_physics/collision/Aabb.h"
 #include "neat_physics/collision/BroadPhaseCallback.h"
 
@@ -26,27 +28,11 @@ public:
 	/// Array of Aabbs
 	using AabbArray = std::vector<Aabb>;
 
-	/// Constructor
-	BroadPhase(const BodyArray& bodies) noexcept :
-		mBodies(bodies)
-	{
-	}
-
-	/// Returns the AABBs of the bodies
-	[[nodiscard]] const AabbArray& getAabbs() const noexcept
-	{
-		return mAabbs;
-	}
-
-	/// Updates the pairs of bodies which AABBs are overlapping
-	void update(BroadPhaseCallback& callback);
-
-private:
 	/// Endpoint of a segment
 	struct Endpoint
 	{
 		/// Coordinate value
-		float position;
+		Real position;
 
 		/// Segment index
 		uint32_t index;
@@ -63,6 +49,77 @@ private:
 		}
 	};
 
+	/// Array of endpoints
+	using EndpointArray = std::vector<Endpoint>;
+
+	/// Constructor
+	BroadPhase(const BodyArray& bodies) noexcept :
+		mBodies(bodies)
+	{
+	}
+
+	/// Returns the AABBs of the bodies
+	[[nodiscard]] const AabbArray& getAabbs() const noexcept
+	{
+		return mAabbs;
+	}
+
+	/// Returns the endpoints in the order of the last update
+	[[nodiscard]] const EndpointArray& getEndpoints() const noexcept
+	{
+		return mEndpoints;
+	}
+
+	/// Returns the instruction set of the sweep kernel
+	[[nodiscard]] KernelIsa getKernelIsa() const noexcept
+	{
+		return mKernelIsa;
+	}
+
+	/// Sets the instruction set of the sweep kernel;
+	/// must be supported, see isKernelIsaSupported
+	void setKernelIsa(KernelIsa isa) noexcept
+	{
+		assert(isKernelIsaSupported(isa));
+		mKernelIsa = isa;
+	}
+
+	/// Updates the pairs of bodies which AABBs are overlapping
+	/// \param speculativeTime If > 0, the AABBs are swept along the body
+	/// velocities over this time, so the pairs which may collide
+	/// during the time are reported too
+	/// \param continuousTime If > 0, the AABBs of the dynamic bullets
+	/// (see Body::isBullet) are expanded in all directions by the distance
+	/// they move over this time, so the pairs give the candidates
+	/// of the continuous collision
+	void update(
+		BroadPhaseCallback& callback,
+		Real speculativeTime = 0.0f,
+		Real continuousTime = 0.0f);
+
+	/// Clears the sweep-and-prune state
+	void clear() noexcept;
+
+	/// Returns the endpoints of all bodies, sorted for the current body poses
+	/// and the speculative and continuous times of the last update.
+	/// The next update starting from these endpoints yields the same
+	/// ordering as the update starting from the current state.
+	[[nodiscard]] EndpointArray getSortedEndpoints() const;
+
+	/// Replaces the endpoints, e.g. with the ones stored in a snapshot;
+	/// must be called after the bodies are set
+	/// \return true on success; false if a segment does not have exactly
+	/// one start and one end endpoint; on failure the state is cleared
+	bool setEndpoints(std::span<const Endpoint> endpoints);
+
+private:
+	/// Adds the endpoints of the bodies added since the last update,
+	/// updates the endpoint positions from the AABBs and sorts the endpoints.
+	/// The sorting is stable, so the ordering depends only on the previous one
+	static void updateEndpoints(
+		const AabbArray& aabbs,
+		EndpointArray& endpoints);
+
 	/// Sweeps the AABBs along the X axis
 	void sweepAxis(BroadPhaseCallback& callback);
 
@@ -73,11 +130,32 @@ private:
 	AabbArray mAabbs;
 
 	/// Endpoints for the sweep-and-prune algorithm
-	std::vector<Endpoint> mEndpoints;
+	EndpointArray mEndpoints;
+
+	/// Instruction set of the sweep kernel
+	KernelIsa mKernelIsa{ KernelIsa::SCALAR };
+
+	/// Speculative time of the last update
+	Real mSpeculativeTime{ 0.0f };
+
+	/// Continuous time of the last update
+	Real mContinuousTime{ 0.0f };
 
 	/// Active set of segment indices during the pruning phase
 	std::vector<uint32_t> mActivePoints;
 
+	/// Minimum Y coordinates of the AABBs in the active set
+	std::vector<Real> mActiveMinY;
+
+	/// Maximum Y coordinates of the AABBs in the active set
+	std::vector<Real> mActiveMaxY;
+
+	/// Static flags of the bodies in the active set, 1 or 0
+	std::vector<Real> mActiveStatic;
+
+	/// Indices in the active set of the AABBs overlapping the current one
+	std::vector<uint32_t> mOverlapSlots;
+
 	/// Mapping for segment index - index in active set during
 	/// the pruning phase
 	std::vector<uint32_t> mActiveMapping;
@@ -53,8 +53,9 @@ struct CollisionPoint
 	/// Contact normal, pointing from body A to body B
 	Vec2 normal;
 
-	/// Penetration depth
-	float penetration;
+	/// Penetration depth; negative for a speculative point
+	/// of separated geometries, see World::setSpeculativeContactsEnabled
+	Real penetration;
 
 	/// Index of the clipping box
 	uint32_t clipBoxIndex;
@@ -68,17 +69,28 @@ struct CollisionPoint
 	/// A pair of features yielding this contact point
 	GeometryFeaturePair featurePair;
 
+	/// Returns the feature pair packed into 8 bits:
+	/// 3 bits per feature (1 bit geometry, 2 bits edge)
+	[[nodiscard]] uint8_t getFeatureId() const noexcept
+	{
+		assert(featurePair[0].edge < 4 && featurePair[1].edge < 4);
+		return static_cast<uint8_t>(
+			(featurePair[0].geometry << 5) |
+			(featurePair[0].edge << 3) |
+			(featurePair[1].geometry << 2) |
+			featurePair[1].edge);
+	}
+
 	/// Default constructor (no initialization)
 	CollisionPoint() noexcept = default;
 
 	/// Constructor
 	/// Asserts:
 	/// - normal is normalized
-	/// - penetration >= 0
 	CollisionPoint(
 		const Vec2& inPosition,
 		const Vec2& inNormal,
-		float inPenetration,
+		Real inPenetration,
 		const GeometryFeaturePair& inFeaturePair,
 		uint32_t inClipBoxIndex,
 		const std::array<Vec2, 2>& inLocalPoints,
@@ -94,7 +106,6 @@ struct CollisionPoint
 		localContactNormal(inLocalContactNormal)
 	{
 		assert(normal.isNormalized());
-		assert(penetration >= 0.0f);
 		assert(clipBoxIndex == 0 || clipBoxIndex == 1);
 		assert(localContactNormal.isNormalized());
 	}
@@ -6,6 +6,7 @@
 
 // Includes
 #include <functional>
+#include <vector>
 #include "neat_physics/collision/BroadPhase.h"
 #include "neat_physics/collision/CollisionCallback.h"
 
@@ -29,20 +30,67 @@ public:
 		return mBroadPhase;
 	}
 
+	/// Returns the broad-phase collision detector (non-const version)
+	[[nodiscard]] BroadPhase& getBroadPhase() noexcept
+	{
+		return mBroadPhase;
+	}
+
+	/// Returns the instruction set of the collision kernels
+	[[nodiscard]] KernelIsa getKernelIsa() const noexcept
+	{
+		return mBroadPhase.getKernelIsa();
+	}
+
+	/// Sets the instruction set of the collision kernels;
+	/// must be supported, see isKernelIsaSupported
+	void setKernelIsa(KernelIsa isa) noexcept
+	{
+		mBroadPhase.setKernelIsa(isa);
+	}
+
 	/// Updates the collision manifolds
-	void update(CollisionCallback& callback);
+	/// \param speculativeTime If > 0, speculative collision points are also
+	/// computed for the separated pairs which may collide during this time
+	/// with the current velocities, see World::setSpeculativeContactsEnabled
+	/// \param continuousTime If > 0, the candidate pairs of the continuous
+	/// collision of the bullets during this time are collected,
+	/// see getContinuousPairs
+	void update(
+		CollisionCallback& callback,
+		Real speculativeTime = 0.0f,
+		Real continuousTime = 0.0f);
+
+	/// Returns the candidate pairs of the continuous collision from the last
+	/// update: a dynamic bullet (see Body::isBullet) and a static body
+	/// or another bullet which the bullet may reach during the continuous time
+	[[nodiscard]] const BroadPhase::BodyIndexPairArray& getContinuousPairs() const noexcept
+	{
+		return mContinuousPairs;
+	}
 
 private:
+	/// Collects the pair of bodies which AABBs are overlapping
 	void onCollision(uint32_t bodyIndA, uint32_t bodyIndB) override;
 
+	/// Computes the manifold of a pair and passes it to the callback
+	void collide(
+		uint32_t bodyIndA,
+		uint32_t bodyIndB,
+		Real speculativeDistance,
+		CollisionCallback& callback);
+
 	/// Reference to the bodies
 	const BodyArray& mBodies;
 
 	/// Broad-phase collision detector
 	BroadPhase mBroadPhase;
 
-	/// A temporary pointer to the collision callback
-	CollisionCallback* mCallback{ nullptr };
+	/// Pairs of bodies which AABBs are overlapping, in the broad phase order
+	BroadPhase::BodyIndexPairArray mPairs;
+
+	/// Candidate pairs of the continuous collision, in the broad phase order
+	BroadPhase::BodyIndexPairArray mContinuousPairs;
 };
 
 } // namespace nph
@@ -5,6 +5,7 @@
 #pragma once
 
 // Includes
+#include "neat_physics/ContactReuseSettings.h"
 #include "neat_physics/collision/CollisionManifold.h"
 #include "neat_physics/dynamics/ContactPoint.h"
 
@@ -16,12 +17,31 @@ namespace nph
 class ContactManifold
 {
 public:
+	/// Persistent state of the manifold, used for snapshots and rollback
+	struct State
+	{
+		/// Persistent states of the contacts
+		std::array<ContactPoint::State, MAX_COLLISION_POINTS> contacts;
+
+		/// Actual contact count
+		uint32_t contactCount;
+	};
+
+	/// Default constructor (no initialization)
+	ContactManifold() noexcept = default;
+
 	/// Constructor
 	ContactManifold(
 		Body& bodyA,
 		Body& bodyB,
 		const CollisionManifold& manifold) noexcept;
 
+	/// Constructor from a persistent state
+	ContactManifold(
+		Body& bodyA,
+		Body& bodyB,
+		const State& state) noexcept;
+
 	/// Returns the first body
 	const Body& getBodyA() const noexcept
 	{
@@ -47,6 +67,15 @@ public:
 		return mContacts[index];
 	}
 
+	/// Returns the contact pair friction coefficient
+	[[nodiscard]] Real getFriction() const noexcept
+	{
+		return mFriction;
+	}
+
+	/// Returns the persistent state
+	[[nodiscard]] State getState() const noexcept;
+
 	/// Returns if the manifold is obsolete
 	[[nodiscard]] bool isObsolete() const noexcept
 	{
@@ -64,14 +93,53 @@ public:
 	void update(const CollisionManifold& newManifold) noexcept;
 
 	/// Prepares the contact manifold for velocity solving
-	void prepareToSolve() noexcept;
+	/// \param reuseSettings Settings of the reuse of the solver data
+	/// of the contacts: if both bodies are close to their poses
+	/// at the last preparation with the same parameters,
+	/// the contacts which can reuse their data only apply the warm starting
+	/// \return the number of the contacts reusing their solver data
+	/// \see ContactPoint::prepareToSolve, ContactPoint::canReuseSolverData
+	uint32_t prepareToSolve(
+		Real speculativeInvTimeStep = 0.0f,
+		Real invMassScaleA = 1.0f,
+		Real invMassScaleB = 1.0f,
+		const ContactReuseSettings& reuseSettings = {}) noexcept;
 
 	/// Solves the contact velocities
+	/// \tparam WITH_FRICTION If false, the friction impulses are not solved
+	template <bool WITH_FRICTION = true>
 	void solveVelocities() noexcept;
 
+	/// Solves the contact velocities of copies of the bodies, see SplitBody
+	void solveVelocities(SplitBody& bodyA, SplitBody& bodyB) noexcept;
+
 	/// Solves the contact positions (penetration)
 	void solvePositions() noexcept;
 
+	/// Solves the contact velocities treating one body as having
+	/// an infinite mass, see ContactPoint::solveVelocitiesWithFixedBody
+	void solveVelocitiesWithFixedBody(uint32_t fixedBodyIndex) noexcept;
+
+	/// Sets the accumulated impulses of a contact
+	/// and applies their changes to the bodies
+	/// \see ContactPoint::setImpulses
+	void setContactImpulses(
+		uint32_t index,
+		Real normalImpulse,
+		Real tangentImpulse) noexcept
+	{
+		assert(index < mContactCount);
+		mContacts[index].setImpulses(*mBodyA, *mBodyB, normalImpulse, tangentImpulse);
+	}
+
+	/// Returns the maximum penetration of the contacts
+	/// for the current body poses, negative for separated contacts
+	[[nodiscard]] Real getMaxPenetration() const noexcept;
+
+	/// Returns the maximum velocity error of the contacts
+	/// \see ContactPoint::getVelocityError
+	[[nodiscard]] Real getMaxVelocityError() const noexcept;
+
 	/// Called when bodies are reallocated
 	/// \param memoryOffset the offset in BYTES between the previously allocated
 	/// and newly allocated body arrays
@@ -79,6 +147,31 @@ public:
 		std::ptrdiff_t memoryOffset) noexcept;
 
 private:
+	/// Body poses and solver parameters of the last preparation
+	/// without the reuse, see prepareToSolve
+	struct PreparedState
+	{
+		/// Positions of the bodies A and B
+		std::array<Vec2, 2> positions;
+
+		/// Rotation angles of the bodies A and B
+		std::array<Real, 2> angles;
+
+		/// Scales of the inverse masses of the bodies A and B
+		std::array<Real, 2> invMassScales;
+
+		/// Inverse time step of the speculative contacts
+		Real speculativeInvTimeStep;
+	};
+
+	/// Returns if the bodies and the solver parameters are close
+	/// to the prepared state
+	[[nodiscard]] bool isNearPreparedState(
+		Real speculativeInvTimeStep,
+		Real invMassScaleA,
+		Real invMassScaleB,
+		const ContactReuseSettings& reuseSettings) const noexcept;
+
 	/// First body
 	Body* mBodyA;
 
@@ -95,7 +188,13 @@ private:
 	bool mObsolete;
 
 	/// Contact pair friction coefficient
-	float mFriction;
+	Real mFriction;
+
+	/// State of the last preparation without the reuse
+	PreparedState mPreparedState;
+
+	/// Flag of the valid mPreparedState
+	bool mIsPrepared;
 };
 
 }
@@ -7,76 +7,268 @@
 // Includes
 #include "neat_physics/collision/CollisionPoint.h"
 #include "neat_physics/Body.h"
+#include "neat_physics/dynamics/SplitBody.h"
 
 namespace nph
 {
 
 /// Represents a contact point between two bodies 
 /// constraining their relative motion
+/// \note The contact is kept compact: only the local anchors,
+/// the packed feature id, the clipping box bit and the impulses persist
+/// between steps. World-space values are derived on demand.
 class ContactPoint
 {
 public:
+	/// Persistent state of the contact, i.e. everything
+	/// except the solver data recomputed in prepareToSolve
+	struct State
+	{
+		/// The contact point in the box local frames
+		std::array<Vec2, 2> localPoints;
+
+		/// Accumulated normal impulse
+		Real normalImpulse;
+
+		/// Accumulated tangent (friction) impulse
+		Real tangentImpulse;
+
+		/// Packed pair of features yielding this contact point
+		uint8_t featureId;
+
+		/// Clipping box index and the local contact normal direction
+		uint8_t flags;
+	};
+
+	/// Contact data of the position solving with the pseudo velocities,
+	/// computed once per solve for the body poses at its start,
+	/// see preparePseudoVelocities
+	struct PseudoContact
+	{
+		/// Contact normal in world space, pointing from body A to body B
+		Vec2 normal;
+
+		/// Vector from the body A center of mass to the contact point
+		Vec2 offsetA;
+
+		/// Vector from the body B center of mass to the contact point
+		Vec2 offsetB;
+
+		/// Penetration depth along the normal
+		Real penetration;
+
+		/// Effective mass in the normal direction
+		Real normalMass;
+	};
+
 	/// Default Constructor (non-initializing)
 	ContactPoint() noexcept = default;
 
 	/// Constructor
-	ContactPoint(const CollisionPoint& inPoint) noexcept :
-		mPoint(inPoint),
-		mNormalImpulse(0.0f),
-		mTangentImpulse(0.0f)
+	ContactPoint(const CollisionPoint& inPoint) noexcept;
+
+	/// Constructor from a persistent state
+	explicit ContactPoint(const State& inState) noexcept :
+		mState(inState),
+		mIsPrepared(false)
 		// The rest of members will be initialized in prepareToSolve
 	{
 	}
 
-	/// Returns the collision point
-	[[nodiscard]] const CollisionPoint& getPoint() const noexcept
+	/// Returns the persistent state
+	[[nodiscard]] const State& getState() const noexcept
+	{
+		return mState;
+	}
+
+	/// Returns the packed feature pair id
+	/// \see CollisionPoint::getFeatureId
+	[[nodiscard]] uint8_t getFeatureId() const noexcept
+	{
+		return mState.featureId;
+	}
+
+	/// Returns the index of the clipping box (0 - 1)
+	[[nodiscard]] uint32_t getClipBoxIndex() const noexcept
+	{
+		return mState.flags & CLIP_BOX_FLAG;
+	}
+
+	/// Returns the contact point in the box local frames
+	[[nodiscard]] const std::array<Vec2, 2>& getLocalPoints() const noexcept
+	{
+		return mState.localPoints;
+	}
+
+	/// Returns the accumulated normal impulse
+	[[nodiscard]] Real getNormalImpulse() const noexcept
 	{
-		return mPoint;
+		return mState.normalImpulse;
 	}
 
+	/// Returns the accumulated tangent (friction) impulse
+	[[nodiscard]] Real getTangentImpulse() const noexcept
+	{
+		return mState.tangentImpulse;
+	}
+
+	/// Computes the world-space contact data for the current body poses
+	/// \param normal Contact normal, pointing from body A to body B
+	/// \param clippedPoint The contact point on the incident box
+	/// \param penetration Penetration depth along the normal
+	void getTransformedContact(
+		const Body& bodyA,
+		const Body& bodyB,
+		Vec2& normal,
+		Vec2& clippedPoint,
+		Real& penetration) const noexcept;
+
 	/// Updates the contact impulses from another one (for warm starting)
+	/// and the solver data, which may be reused, see canReuseSolverData
 	void updateFrom(const ContactPoint& other) noexcept;
 
 	/// Prepares the contact point for velocity solving;
+	/// \param speculativeInvTimeStep Inverse time step if the speculative
+	/// contacts are enabled, otherwise 0. A speculative contact of separated
+	/// bodies allows the approach velocity which closes exactly the gap
+	/// during the time step.
+	/// \param invMassScaleA, invMassScaleB Scales of the inverse masses
+	/// and inertias of the bodies in the effective masses, see SplitBody;
+	/// the warm starting impulse is applied with the actual masses
 	void prepareToSolve(
 		Body& bodyA,
-		Body& bodyB) noexcept;
+		Body& bodyB,
+		Real speculativeInvTimeStep = 0.0f,
+		Real invMassScaleA = 1.0f,
+		Real invMassScaleB = 1.0f) noexcept;
 	
+	/// Applies the warm starting impulse, i.e. the accumulated impulses;
+	/// called by prepareToSolve
+	void warmStart(Body& bodyA, Body& bodyB) const noexcept;
+
+	/// Returns if the solver data of the last prepareToSolve can be reused
+	/// for close body poses: the contact is prepared and is not a separated
+	/// speculative contact, whose gap velocity depends on the poses
+	/// \see ContactReuseSettings
+	[[nodiscard]] bool canReuseSolverData() const noexcept
+	{
+		return mIsPrepared && mGapVelocity == 0.0f;
+	}
+
 	/// Solves the contact velocities
 	/// asserts that friction is in [0, 1]
+	/// \tparam WITH_FRICTION If false, the friction impulse is not solved
+	/// \tparam BodyType Body or SplitBody
+	template <bool WITH_FRICTION = true, typename BodyType = Body>
 	void solveVelocities(
-		Body& bodyA,
-		Body& bodyB,
-		float friction) noexcept;
+		BodyType& bodyA,
+		BodyType& bodyB,
+		Real friction) noexcept;
 
 	/// Solves the contact position (penetration)
 	void solvePositions(Body& bodyA, Body& bodyB) noexcept;
+
+	/// Computes the contact data of the position solving
+	/// with the pseudo velocities for the current body poses
+	void preparePseudoVelocities(
+		const Body& bodyA,
+		const Body& bodyB,
+		PseudoContact& pseudoContact) const noexcept;
+
+	/// Solves the contact position with the pseudo velocities: the same
+	/// correction as solvePositions, but the penetration is linearized
+	/// around the prepared poses and the correction is accumulated
+	/// in the copies of the bodies instead of their poses
+	/// \param bodyA, bodyB Copies of the bodies with the displacements
+	/// and the rotations accumulated since the preparation
+	/// in the linear and the angular velocities
+	static void solvePseudoVelocities(
+		const PseudoContact& pseudoContact,
+		SplitBody& bodyA,
+		SplitBody& bodyB) noexcept;
+
+	/// Solves the contact velocities treating one body as having
+	/// an infinite mass, for the shock propagation
+	/// \param fixedBodyIndex Index of the body in the pair (0 - 1)
+	/// which is not moved by the impulses
+	void solveVelocitiesWithFixedBody(
+		Body& bodyA,
+		Body& bodyB,
+		Real friction,
+		uint32_t fixedBodyIndex) noexcept;
+
+	/// Returns the contact normal in world space, pointing from body A
+	/// to body B, valid after prepareToSolve
+	[[nodiscard]] const Vec2& getNormal() const noexcept
+	{
+		return mNormal;
+	}
+
+	/// Returns the vector from the body A center of mass
+	/// to the contact point, valid after prepareToSolve
+	[[nodiscard]] const Vec2& getOffsetA() const noexcept
+	{
+		return mOffsetA;
+	}
+
+	/// Returns the vector from the body B center of mass
+	/// to the contact point, valid after prepareToSolve
+	[[nodiscard]] const Vec2& getOffsetB() const noexcept
+	{
+		return mOffsetB;
+	}
+
+	/// Returns the approach velocity closing the gap of a speculative
+	/// contact, valid after prepareToSolve
+	[[nodiscard]] Real getGapVelocity() const noexcept
+	{
+		return mGapVelocity;
+	}
+
+	/// Sets the accumulated impulses and applies their changes to the bodies,
+	/// e.g. for the impulses computed by a direct solver
+	void setImpulses(
+		Body& bodyA,
+		Body& bodyB,
+		Real normalImpulse,
+		Real tangentImpulse) noexcept;
+
+	/// Returns the error of the normal velocity constraint, valid after
+	/// prepareToSolve: the approach velocity if the normal impulse is 0,
+	/// otherwise the absolute normal velocity (the impulse must vanish
+	/// or the bodies must not move along the normal)
+	[[nodiscard]] Real getVelocityError(
+		const Body& bodyA,
+		const Body& bodyB) const noexcept;
 	
 private:
+	/// Flag bit: index of the clipping box
+	static constexpr uint8_t CLIP_BOX_FLAG = 1 << 0;
+
+	/// Flag bit: the contact normal is the y axis of the clipping box
+	static constexpr uint8_t NORMAL_AXIS_FLAG = 1 << 1;
+
+	/// Flag bit: the contact normal points along the negative axis
+	static constexpr uint8_t NORMAL_SIGN_FLAG = 1 << 2;
+
 	/// Returns the relative velocity at the contact point
+	template <typename BodyType>
 	[[nodiscard]] Vec2 getVelocityAtContact(
-		const Body& bodyA,
-		const Body& bodyB) const noexcept;
+		const BodyType& bodyA,
+		const BodyType& bodyB) const noexcept;
 
 	/// Applies an impulse at the contact point
+	template <typename BodyType>
 	void applyImpulse(
-		Body& bodyA,
-		Body& bodyB,
+		BodyType& bodyA,
+		BodyType& bodyB,
 		const Vec2& impulse) const noexcept;
 
-	/// Gets the transformed contact data
-	void getTransformedContact(
-		const Body& bodyA,
-		const Body& bodyB,
-		Vec2& normal,
-		Vec2& clippedPoint,
-		float& penetration) const;
-
-	/// Collision point
-	CollisionPoint mPoint;
+	/// Persistent state
+	State mState;
 
-	/// Tangent vector
-	Vec2 mTangent;
+	/// Contact normal in world space, valid after prepareToSolve
+	Vec2 mNormal;
 
 	/// Vector from the body A center of mass to the contact point
 	Vec2 mOffsetA;
@@ -85,16 +277,17 @@ private:
 	Vec2 mOffsetB;
 
 	/// Effective mass in the normal direction
-	float mNormalMass;
+	Real mNormalMass;
 
 	/// Effective mass in the tangent direction
-	float mTangentMass;
+	Real mTangentMass;
 
-	/// Accumulated normal impulse
-	float mNormalImpulse;
+	/// Approach velocity closing the gap of a speculative contact
+	/// during the time step, 0 for a penetrating contact
+	Real mGapVelocity;
 
-	/// Accumulated tangent (friction) impulse
-	float mTangentImpulse;
+	/// Flag of the valid solver data, set by prepareToSolve
+	bool mIsPrepared;
 };
 
 }
@@ -5,9 +5,14 @@
 #pragma once
 
 // Includes
+#include <limits>
+#include <span>
 #include <unordered_map>
+#include "neat_physics/VelocitySolver.h"
 #include "neat_physics/collision/CollisionCallback.h"
 #include "neat_physics/dynamics/ContactManifold.h"
+#include "neat_physics/dynamics/DirectSolver.h"
+#include "neat_physics/dynamics/IslandBuilder.h"
 
 namespace nph
 {
@@ -29,6 +34,30 @@ public:
 	/// Array of contact manifolds
 	using ManifoldsArray = std::vector<ManifoldsArrayEntry>;
 
+	/// Persistent state of a contact manifold with the key of its body pair,
+	/// used to store the manifolds in snapshots and rollback states
+	struct ManifoldRecord
+	{
+		/// Combination of two body IDs, see ContactPairsMap
+		uint64_t bodyPairKey;
+
+		/// Persistent state of the manifold
+		ContactManifold::State state;
+	};
+
+	/// Array of manifold records
+	using ManifoldRecordArray = std::vector<ManifoldRecord>;
+
+	/// Statistics of the last solveVelocitiesWithDirectSolve call
+	struct DirectSolveStats
+	{
+		/// Number of the islands solved with the direct solver
+		uint32_t islandCount;
+
+		/// Maximum number of the direct solver iterations of an island
+		uint32_t maxIterationCount;
+	};
+
 	/// Constructor
 	ContactSolver(BodyArray& bodies) noexcept;
 
@@ -51,28 +80,259 @@ public:
 	void finishManifoldsUpdate();
 
 	/// Prepares the contact solver for velocity solving
-	void prepareToSolve() noexcept;
+	/// \param velocitySolver Solver of the following velocity iterations;
+	/// the Jacobi iteration scales the effective masses of the contacts,
+	/// see solveVelocitiesWithCopies
+	/// \param jacobiRelaxation Relaxation of the Jacobi iteration,
+	/// asserted to be in (0, 1]
+	/// \param reuseSettings Settings of the reuse of the prepared contact data
+	/// \see ContactManifold::prepareToSolve
+	void prepareToSolve(
+		Real speculativeInvTimeStep = 0.0f,
+		VelocitySolver velocitySolver = VelocitySolver::GAUSS_SEIDEL,
+		Real jacobiRelaxation = 1.0f,
+		const ContactReuseSettings& reuseSettings = {});
+
+	/// Returns the number of the contacts of the last prepareToSolve
+	[[nodiscard]] uint32_t getContactCount() const noexcept
+	{
+		return mContactCount;
+	}
+
+	/// Returns the number of the contacts reusing the solver data
+	/// in the last prepareToSolve, see ContactReuseSettings
+	[[nodiscard]] uint32_t getReusedContactCount() const noexcept
+	{
+		return mReusedContactCount;
+	}
 
 	/// Solves the contact velocities
 	void solveVelocities(uint32_t velocityIterations) noexcept;
 
+	/// Solves the contact velocities with copies of the bodies (see SplitBody)
+	/// for the Jacobi iteration, as prepared, see VelocitySolver::JACOBI.
+	/// All manifolds of an iteration start from the same velocities,
+	/// so they can be solved in parallel, then their velocity changes
+	/// are summed in the manifold order.
+	void solveVelocitiesWithCopies(uint32_t velocityIterations) noexcept;
+
+	/// Solves the contact velocities of the islands with at most
+	/// maxDirectConstraints constraints (2 per contact) with the direct
+	/// solver in one shot, see DirectSolver; the manifolds of the larger
+	/// islands are iterated as by solveVelocities
+	/// \note Builds the islands, see getIslands
+	void solveVelocitiesWithDirectSolve(
+		uint32_t velocityIterations,
+		uint32_t maxDirectConstraints);
+
+	/// Returns the statistics of the last solveVelocitiesWithDirectSolve call
+	[[nodiscard]] const DirectSolveStats& getDirectSolveStats() const noexcept
+	{
+		return mDirectSolveStats;
+	}
+
 	/// Solves the contact positions (penetration)
 	void solvePositions(uint32_t positionIterations) noexcept;
 
+	/// Solves the contact positions with the pseudo velocities:
+	/// the contacts are transformed once, the iterations accumulate
+	/// the corrections of the bodies linearly, and the poses are updated
+	/// once after the iterations, see PositionSolver::PSEUDO_VELOCITIES
+	void solvePositionsWithPseudoVelocities(uint32_t positionIterations);
+
+	/// Solves the contact velocities with a compile-time configuration
+	/// \see StepConfig
+	template <uint32_t VELOCITY_ITERATIONS, bool WITH_FRICTION>
+	void solveVelocities() noexcept
+	{
+		for (uint32_t i = 0; i < VELOCITY_ITERATIONS; ++i)
+		{
+			for (auto& pair : mManifolds)
+			{
+				pair.second.template solveVelocities<WITH_FRICTION>();
+			}
+		}
+	}
+
+	/// Solves the contact positions with a compile-time iteration count
+	/// \see StepConfig
+	template <uint32_t POSITION_ITERATIONS>
+	void solvePositions() noexcept
+	{
+		for (uint32_t i = 0; i < POSITION_ITERATIONS; ++i)
+		{
+			for (auto& pair : mManifolds)
+			{
+				pair.second.solvePositions();
+			}
+		}
+	}
+
+	/// Builds the islands of the current manifolds, see getIslands
+	void buildIslands();
+
+	/// Returns the islands built by the last call of buildIslands;
+	/// the manifold indices refer to getManifolds
+	[[nodiscard]] const IslandBuilder& getIslands() const noexcept
+	{
+		return mIslands;
+	}
+
+	/// Returns the mass ratio of each island of the current manifolds:
+	/// the ratio of the maximum and the minimum mass of its dynamic bodies
+	void getIslandMassRatios(std::vector<Real>& ratios) const;
+
+	/// Prepares the shock propagation after prepareToSolve: assigns each body
+	/// a level by a breadth-first search from the static bodies over
+	/// the supporting contacts, the ones with the normal close to the gravity,
+	/// and orders the manifolds by the lower level of their bodies
+	void prepareShockPropagation(const Vec2& gravity);
+
+	/// Solves the contact velocities propagating the shocks upwards:
+	/// the manifolds are solved from the static bodies upwards, and
+	/// the lower-level body of a manifold is treated as having an infinite
+	/// mass, so the upper bodies cannot push it down; the side manifolds
+	/// and the ones between bodies of the same level are solved as usual. Converges a stack
+	/// in a single iteration, but makes the lower bodies ignore
+	/// the upper ones, so only the last iterations should use it.
+	void solveVelocitiesWithShock(uint32_t velocityIterations) noexcept;
+
+	/// Returns the maximum penetration of the contacts
+	/// for the current body poses, 0 if there are no penetrating contacts
+	[[nodiscard]] Real getMaxPenetration() const noexcept;
+
+	/// Returns the maximum velocity error of the contacts,
+	/// i.e. the residual of the velocity iterations of the last step
+	/// \see ContactPoint::getVelocityError
+	[[nodiscard]] Real getMaxVelocityError() const noexcept;
+
 	/// Called when bodies are reallocated
 	/// \param memoryOffset the offset in BYTES between the previously allocated
 	/// and newly allocated body arrays
 	void onBodiesReallocation(std::ptrdiff_t memoryOffsetInBytes) noexcept;
 
+	/// Returns the persistent states of the manifolds in the solving order
+	void getManifoldRecords(ManifoldRecordArray& records) const;
+
+	/// Replaces the persistent manifolds, e.g. with the ones stored in a snapshot;
+	/// must be called after the bodies are set
+	/// \return true on success; on failure the manifolds are cleared
+	bool setManifolds(std::span<const ManifoldRecord> records);
+
 private:
+	/// Returns the body index pairs of the manifolds
+	void getBodyPairs(std::vector<std::pair<uint32_t, uint32_t>>& pairs) const;
+
+	/// Returns the mass ratio of an island, see getIslandMassRatios
+	[[nodiscard]] Real getIslandMassRatio(
+		const IslandBuilder& islands,
+		uint32_t islandIndex) const noexcept;
+
+	/// Returns the index of a body in the body array
+	[[nodiscard]] uint32_t getBodyIndex(const Body& body) const noexcept
+	{
+		return static_cast<uint32_t>(&body - mBodies.data());
+	}
+
 	/// Reference to the body array
 	BodyArray& mBodies;
 
 	/// Persistent contact manifolds
 	ContactPairsMap mContactPairs;
 
+	/// Manifold in the shock propagation order
+	struct ShockManifold
+	{
+		/// Index of the manifold
+		uint32_t manifoldIndex;
+
+		/// Index of the lower-level body in the pair (0 - 1),
+		/// or NO_FIXED_BODY for a side contact, for the bodies
+		/// of the same level or if one of them is static
+		uint32_t fixedBodyIndex;
+
+		/// Lower level of the bodies, see prepareShockPropagation
+		uint32_t level;
+	};
+
+	/// Marks a manifold solved without a fixed body
+	static constexpr uint32_t NO_FIXED_BODY = 2;
+
+	/// Level of the bodies not supported by a static body
+	static constexpr uint32_t UNSUPPORTED_LEVEL =
+		std::numeric_limits<uint32_t>::max();
+
 	/// Contact manifolds
 	ManifoldsArray mManifolds;
+
+	/// Body index pairs of the manifolds for the island building
+	std::vector<std::pair<uint32_t, uint32_t>> mBodyPairs;
+
+	/// Islands of the manifolds
+	IslandBuilder mIslands;
+
+	/// Supporting body of each manifold (0 - 1), or NO_FIXED_BODY
+	/// for a side contact, see prepareShockPropagation
+	std::vector<uint32_t> mSupportingBodies;
+
+	/// Start of the bodies supported by each body
+	/// in mBodyNeighbors and the total count at the end
+	std::vector<uint32_t> mBodyNeighborStarts;
+
+	/// Current end of the neighbors of each body during the graph building
+	std::vector<uint32_t> mBodyNeighborEnds;
+
+	/// Bodies supported by each body
+	std::vector<uint32_t> mBodyNeighbors;
+
+	/// Shock propagation level of each body, see prepareShockPropagation
+	std::vector<uint32_t> mBodyLevels;
+
+	/// Queue of the breadth-first search of the body levels
+	std::vector<uint32_t> mLevelQueue;
+
+	/// Manifolds in the shock propagation order
+	std::vector<ShockManifold> mShockOrder;
+
+	/// Solver of the small islands
+	DirectSolver mDirectSolver;
+
+	/// Manifolds of the island passed to the direct solver
+	std::vector<ContactManifold*> mDirectManifolds;
+
+	/// Indices of the manifolds of the islands too large for the direct solver
+	std::vector<uint32_t> mIterativeManifolds;
+
+	/// Statistics of the last direct solve
+	DirectSolveStats mDirectSolveStats{};
+
+	/// Number of the contacts of the last preparation
+	uint32_t mContactCount{ 0 };
+
+	/// Number of the contacts reusing the solver data in the last preparation
+	uint32_t mReusedContactCount{ 0 };
+
+	/// Number of the copies of every body for the Jacobi iteration,
+	/// the inverse relaxation
+	Real mSplitCount{ 1.0f };
+
+	/// Share of a copy in the velocity of its body, 1 / count
+	Real mSplitShare{ 1.0f };
+
+	/// Contact data of the position solving with the pseudo velocities
+	std::vector<ContactPoint::PseudoContact> mPseudoContacts;
+
+	/// Body indices (A, B) of each element of mPseudoContacts
+	std::vector<std::pair<uint32_t, uint32_t>> mPseudoContactBodies;
+
+	/// Copy of each body accumulating the position correction
+	/// with the pseudo velocities: the displacement and the rotation
+	/// are stored as the linear and the angular velocity
+	std::vector<SplitBody> mPseudoBodies;
+
+	/// Copies of the bodies of each manifold (A, B) for the Jacobi iteration,
+	/// the velocity changes after solving the manifolds
+	std::vector<SplitBody> mSplitBodies;
 };
 
 }
@@ -0,0 +1,179 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <span>
+#include <vector>
+#include "neat_physics/dynamics/ContactManifold.h"
+
+namespace nph
+{
+
+/// Solves the contact velocities of a small island exactly:
+/// builds the dense matrix J * inv(M) * transpose(J) of the normal
+/// and friction constraints of the island and solves the linear
+/// complementarity problem with an active set method. A few projected
+/// Gauss-Seidel iterations on the matrix guess the state of each contact:
+/// separated, sticking or sliding. The linear system of the guess is solved
+/// by the Gaussian elimination, and the contacts violating the constraints
+/// change the state (block principal pivoting). If the pivoting does not
+/// find a solution the iterations continue. The elimination costs
+/// (number of constraints)^3 operations, so the solver suits
+/// the islands with a few constraints only.
+class DirectSolver
+{
+public:
+	/// Maximum number of the projected Gauss-Seidel iterations of a solve
+	static constexpr uint32_t MAX_ITERATIONS = 256;
+
+	/// Number of the projected Gauss-Seidel iterations
+	/// before an attempt to solve the active set
+	static constexpr uint32_t ACTIVE_SET_ITERATIONS = 8;
+
+	/// Maximum constraint velocity error of a solution
+	static constexpr Real VELOCITY_TOLERANCE = 1.0e-4f;
+
+	/// Maximum number of the active set changes after an iteration block
+	static constexpr uint32_t MAX_PIVOTS = 8;
+
+	/// Relative tolerance of the friction bound of a sticking contact,
+	/// which avoids the cycling between the sticking and the sliding
+	/// of a contact on the verge of sliding; the accepted friction
+	/// impulse is clamped to the bound
+	static constexpr Real FRICTION_TOLERANCE = 0.01f;
+
+	/// Relative regularization of the diagonal of the active set system,
+	/// which is singular for redundant contacts, e.g. for the 2 contacts
+	/// of a box resting on another box
+	static constexpr Real REGULARIZATION = 1.0e-6f;
+
+	/// Solves the contact velocities of the manifolds of an island,
+	/// prepared with ContactManifold::prepareToSolve; the accumulated
+	/// impulses of the contacts are the starting solution, the changes
+	/// of the impulses are applied to the bodies at the end
+	/// \return the number of the projected Gauss-Seidel iterations
+	uint32_t solve(std::span<ContactManifold* const> manifolds);
+
+private:
+	/// Marks a static body of a constraint
+	static constexpr uint32_t NO_BODY = 0xFFFFFFFF;
+
+	/// State of a contact in the active set
+	enum class ContactState : uint8_t
+	{
+		/// The normal and the friction impulses are 0
+		SEPARATED,
+
+		/// The normal and the tangent velocities are 0
+		STICKING,
+
+		/// The normal velocity is 0, the friction impulse is at the upper bound
+		SLIDING_POSITIVE,
+
+		/// The normal velocity is 0, the friction impulse is at the lower bound
+		SLIDING_NEGATIVE
+	};
+
+	/// Jacobian row of a constraint
+	struct Row
+	{
+		/// Indices of the bodies A and B in mBodies, NO_BODY for the static ones
+		std::array<uint32_t, 2> bodies;
+
+		/// Linear parts of the Jacobian for the bodies A and B
+		std::array<Vec2, 2> linear;
+
+		/// Angular parts of the Jacobian for the bodies A and B
+		std::array<Real, 2> angular;
+	};
+
+	/// Returns the index of a dynamic body in mBodies, adding the body
+	/// if needed, or NO_BODY for a static body
+	[[nodiscard]] uint32_t addBody(const Body& body);
+
+	/// Returns the element of the matrix for two constraints
+	[[nodiscard]] Real getMatrixElement(const Row& rowI, const Row& rowJ) const noexcept;
+
+	/// Returns the velocity of a constraint for the impulse changes
+	[[nodiscard]] Real getVelocity(
+		size_t row,
+		const std::vector<Real>& impulseChanges) const noexcept;
+
+	/// Runs the projected Gauss-Seidel iterations
+	/// \param iterationCount Total number of iterations, incremented
+	/// \return true if the iterations have converged
+	bool iterate(uint32_t iterations, uint32_t& iterationCount) noexcept;
+
+	/// Solves the contact states guessed from the current impulses
+	/// with the block principal pivoting; on success replaces
+	/// the impulses with the solution
+	/// \return true if a solution satisfying the constraints is found
+	bool solveActiveSet();
+
+	/// Solves the linear system of the contact states into mSolution
+	/// \return false if the system is singular
+	bool solveLinearSystem();
+
+	/// Changes the states of the contacts violating the constraints
+	/// for mSolution
+	/// \param isFailed Set to true if the violation cannot be fixed
+	/// by the state changes, i.e. the precision of the solution is too low
+	/// \return true if no contact violates the constraints
+	bool updateContactStates(bool& isFailed);
+
+	/// Returns the direction of the friction impulse of a sliding contact:
+	/// 1 or -1, 0 for other states
+	[[nodiscard]] Real getSlidingSign(size_t contact) const noexcept
+	{
+		switch (mContactStates[contact])
+		{
+		case ContactState::SLIDING_POSITIVE:
+			return 1.0f;
+		case ContactState::SLIDING_NEGATIVE:
+			return -1.0f;
+		default:
+			return 0.0f;
+		}
+	}
+
+	/// Dynamic bodies of the island
+	std::vector<const Body*> mBodies;
+
+	/// Constraints: the normal and the friction constraint of each contact
+	std::vector<Row> mRows;
+
+	/// Matrix J * inv(M) * transpose(J), row-major
+	std::vector<Real> mMatrix;
+
+	/// Constraint velocities for the starting impulses
+	std::vector<Real> mVelocities;
+
+	/// Accumulated impulses
+	std::vector<Real> mImpulses;
+
+	/// Changes of the accumulated impulses from the starting ones
+	std::vector<Real> mImpulseChanges;
+
+	/// Friction coefficient of each contact
+	std::vector<Real> mFrictions;
+
+	/// Active set: the constraint of each unknown impulse
+	std::vector<uint32_t> mUnknowns;
+
+	/// State of each contact
+	std::vector<ContactState> mContactStates;
+
+	/// Augmented matrix of the active set system, row-major
+	std::vector<Real> mSystem;
+
+	/// Impulses of the active set solution
+	std::vector<Real> mSolution;
+
+	/// Impulse changes of the active set solution
+	std::vector<Real> mSolutionChanges;
+};
+
+} // namespace nph
@@ -0,0 +1,76 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <span>
+#include <vector>
+#include "neat_physics/Body.h"
+
+namespace nph
+{
+
+/// Groups the contact manifolds into islands: sets of manifolds
+/// connected through dynamic bodies. The static bodies do not connect
+/// the islands, so a manifold with a static body belongs to the island
+/// of its dynamic body.
+class IslandBuilder
+{
+public:
+	/// Builds the islands
+	/// \param bodies The bodies of the manifolds
+	/// \param bodyPairs Indices of the bodies of each manifold
+	/// (see ContactSolver::getManifolds), at least one of them dynamic
+	void build(
+		const BodyArray& bodies,
+		std::span<const std::pair<uint32_t, uint32_t>> bodyPairs);
+
+	/// Returns the number of islands
+	[[nodiscard]] uint32_t getIslandCount() const noexcept
+	{
+		return static_cast<uint32_t>(mIslandStarts.size()) - 1;
+	}
+
+	/// Returns the indices of the manifolds of an island in the ascending order
+	/// \param islandIndex Index of the island; asserted to be valid
+	[[nodiscard]] std::span<const uint32_t> getIslandManifolds(
+		uint32_t islandIndex) const noexcept
+	{
+		assert(islandIndex < getIslandCount());
+		return {
+			mManifoldIndices.data() + mIslandStarts[islandIndex],
+			mManifoldIndices.data() + mIslandStarts[islandIndex + 1] };
+	}
+
+	/// Returns the indices of the manifolds grouped by the islands
+	[[nodiscard]] std::span<const uint32_t> getManifoldIndices() const noexcept
+	{
+		return mManifoldIndices;
+	}
+
+private:
+	/// Returns the root of the body set (union-find with path halving)
+	[[nodiscard]] uint32_t findRoot(uint32_t bodyIndex) noexcept;
+
+	/// Parents of the body sets
+	std::vector<uint32_t> mParents;
+
+	/// Island index of each root body
+	std::vector<uint32_t> mRootIslands;
+
+	/// Island index of each manifold
+	std::vector<uint32_t> mManifoldIslands;
+
+	/// Current end of each island during the sorting of the manifolds
+	std::vector<uint32_t> mIslandEnds;
+
+	/// Indices of the manifolds grouped by the islands
+	std::vector<uint32_t> mManifoldIndices;
+
+	/// Start of each island in mManifoldIndices and the total count at the end
+	std::vector<uint32_t> mIslandStarts{ 0 };
+};
+
+} // namespace nph
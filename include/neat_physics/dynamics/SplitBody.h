@@ -0,0 +1,32 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include "neat_physics/math/Vec2.h"
+
+namespace nph
+{
+
+/// Copy of the velocity of a body seen by a single contact manifold
+/// in the solvers combining the impulses of several manifolds, see VelocitySolver
+/// The member names match the ones of Body, so the contacts solve
+/// the copies and the bodies with the same code.
+struct SplitBody
+{
+	/// Linear velocity
+	Vec2 linearVelocity;
+
+	/// Angular velocity
+	Real angularVelocity;
+
+	/// Inverse mass, scaled by the solver
+	Real invMass;
+
+	/// Inverse moment of inertia, scaled by the solver
+	Real invInertia;
+};
+
+} // namespace nph
@@ -0,0 +1,104 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <bit>
+#include <cstdint>
+
+namespace nph
+{
+
+/// Sine and cosine of an angle or of the lanes of a wide angle
+template <typename T>
+struct BasicSinCos
+{
+	/// Sine
+	T sin;
+
+	/// Cosine
+	T cos;
+};
+
+/// Maximum absolute error of fastSinCos for |angleRad| <= FAST_SIN_COS_MAX_ANGLE,
+/// less than 1 ulp of 1 (the measured maximum is 7.8e-8); the relative error
+/// near the zeros of sine and cosine is larger, but the error of a rotation
+/// matrix is absolute
+inline constexpr float FAST_SIN_COS_MAX_ERROR = 1.0e-7f;
+
+/// Maximum angle in radians for FAST_SIN_COS_MAX_ERROR; beyond it the error
+/// of the range reduction grows about linearly with the angle
+/// (1e-6 at 2^16), and the result is meaningless for |angleRad| >= 2^22
+inline constexpr float FAST_SIN_COS_MAX_ANGLE = 8192.0f;
+
+/// Scalar counterpart of the per-lane selection of the wide types;
+/// branchless, since the quadrants of fastSinCos are unpredictable
+[[nodiscard]] inline float select(bool mask, float a, float b) noexcept
+{
+	const uint32_t bits = 0u - static_cast<uint32_t>(mask);
+	return std::bit_cast<float>(
+		(std::bit_cast<uint32_t>(a) & bits) |
+		(std::bit_cast<uint32_t>(b) & ~bits));
+}
+
+/// Polynomial sine and cosine of float or of a wide float type (simd::FloatW)
+/// The angle is reduced to [-pi / 4, pi / 4] by subtracting a multiple of pi / 2
+/// split into 3 parts (Cody-Waite), then minimax polynomials of degree 7 (sine)
+/// and 8 (cosine) are evaluated and swapped / negated by the quadrant.
+/// Only additions, multiplications, comparisons and selections are used,
+/// so the scalar and all wide variants produce the same bits, provided
+/// the compiler does not contract them into FMA. NaN and infinite angles
+/// produce NaN.
+/// \see FAST_SIN_COS_MAX_ERROR
+template <typename F>
+[[nodiscard]] BasicSinCos<F> fastSinCos(const F& angleRad) noexcept
+{
+	// Adding and subtracting 1.5 * 2^23 rounds a float to an integer
+	// for |value| < 2^22 with the default rounding to nearest
+	const F ROUNDING(12582912.0f);
+	const F TWO_OVER_PI(0.636619772367581343f);
+
+	// pi / 2 = PI_OVER_2_1 + PI_OVER_2_2 + PI_OVER_2_3; the first parts have
+	// few significant bits, so their products with the quadrant number are exact
+	const F PI_OVER_2_1(1.5703125f);
+	const F PI_OVER_2_2(4.837512969970703125e-4f);
+	const F PI_OVER_2_3(7.54978995489188216e-8f);
+
+	// Nearest multiple of pi / 2 and the remainder in [-pi / 4, pi / 4]
+	const F multiple = (angleRad * TWO_OVER_PI + ROUNDING) - ROUNDING;
+	const F x =
+		((angleRad - multiple * PI_OVER_2_1) -
+		multiple * PI_OVER_2_2) -
+		multiple * PI_OVER_2_3;
+
+	// Quadrant = multiple mod 4, in [0, 3]
+	const F quarter = multiple * F(0.25f);
+	F floorQuarter = (quarter + ROUNDING) - ROUNDING;
+	floorQuarter = floorQuarter - select(quarter < floorQuarter, F(1.0f), F(0.0f));
+	const F quadrant = multiple - F(4.0f) * floorQuarter;
+
+	// Minimax polynomials (Cephes sinf / cosf)
+	const F z = x * x;
+	const F s =
+		((F(-1.9515295891e-4f) * z + F(8.3321608736e-3f)) * z +
+		F(-1.6666654611e-1f)) * z * x + x;
+	const F c =
+		((F(2.443315711809948e-5f) * z + F(-1.388731625493765e-3f)) * z +
+		F(4.166664568298827e-2f)) * z * z - F(0.5f) * z + F(1.0f);
+
+	// sin(x + q * pi / 2), cos(x + q * pi / 2):
+	// q = 0: (s, c), q = 1: (c, -s), q = 2: (-s, -c), q = 3: (-c, s)
+	const auto isOdd = (quadrant == F(1.0f)) | (quadrant == F(3.0f));
+	const auto isSinNegative = quadrant >= F(2.0f);
+	const auto isCosNegative = (quadrant == F(1.0f)) | (quadrant == F(2.0f));
+
+	const F sinAbs = select(isOdd, c, s);
+	const F cosAbs = select(isOdd, s, c);
+	return {
+		select(isSinNegative, -sinAbs, sinAbs),
+		select(isCosNegative, -cosAbs, cosAbs) };
+}
+
+} // namespace nph
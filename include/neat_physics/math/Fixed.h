@@ -0,0 +1,410 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+namespace nph
+{
+
+/// Sine of a phase given in 1/2^32 turns, in Q30 format (1.0 = 2^30)
+/// Uses a quarter-wave table with linear interpolation,
+/// the absolute error is below 1.2e-6
+[[nodiscard]] int32_t sinTurnsQ30(uint32_t phase) noexcept;
+
+/// Integer square root, rounded down
+[[nodiscard]] constexpr uint64_t integerSquareRoot(uint64_t value) noexcept
+{
+	uint64_t result = 0;
+	uint64_t bit = uint64_t(1) << 62;
+	while (bit > value)
+	{
+		bit >>= 2;
+	}
+	while (bit != 0)
+	{
+		if (value >= result + bit)
+		{
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else
+		{
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+	return result;
+}
+
+/// Returns (a * b) >> shift rounded to the nearest, truncated to 64 bits
+/// \pre 0 < shift < 64
+[[nodiscard]] inline int64_t multiplyShift(
+	int64_t a,
+	int64_t b,
+	int shift) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+	const __int128 product =
+		static_cast<__int128>(a) * b + (static_cast<__int128>(1) << (shift - 1));
+	return static_cast<int64_t>(product >> shift);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	int64_t high;
+	uint64_t low = static_cast<uint64_t>(_mul128(a, b, &high));
+	const uint64_t half = uint64_t(1) << (shift - 1);
+	low += half;
+	high += low < half;
+	return static_cast<int64_t>(
+		__shiftright128(low, static_cast<uint64_t>(high), static_cast<unsigned char>(shift)));
+#else
+#error "128-bit multiplication is not supported on this platform"
+#endif
+}
+
+/// Returns ((high << 64) | low) / divisor
+/// \pre high < divisor
+[[nodiscard]] inline uint64_t divide128(
+	uint64_t high,
+	uint64_t low,
+	uint64_t divisor) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+	return static_cast<uint64_t>(
+		((static_cast<unsigned __int128>(high) << 64) | low) / divisor);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	uint64_t remainder;
+	return _udiv128(high, low, divisor, &remainder);
+#else
+#error "128-bit division is not supported on this platform"
+#endif
+}
+
+/// Signed fixed-point number with FRACTION_BITS fractional bits
+/// All operations are integer ones, so the results are bit-exact on any
+/// platform and with any compiler flags. Addition and subtraction wrap
+/// around on overflow, multiplication rounds to the nearest,
+/// division truncates toward zero and saturates on overflow
+/// and on division by zero.
+template <int FRACTION_BITS, typename Storage>
+class Fixed
+{
+	static_assert(std::is_integral_v<Storage> && std::is_signed_v<Storage>);
+	static_assert(sizeof(Storage) == 4 || sizeof(Storage) == 8);
+	static_assert(FRACTION_BITS > 0 && FRACTION_BITS < int(sizeof(Storage) * 8) - 1);
+
+public:
+	/// Raw storage type
+	using RawType = Storage;
+
+	/// Raw value of 1.0
+	static constexpr Storage ONE = Storage(1) << FRACTION_BITS;
+
+	/// Default constructor (no initialization)
+	Fixed() noexcept = default;
+
+	/// Constructor from an arithmetic value, rounds to the nearest
+	/// and saturates values out of the range
+	template <typename T>
+		requires std::is_arithmetic_v<T>
+	constexpr Fixed(T value) noexcept :
+		mRaw(toRaw(value))
+	{
+	}
+
+	/// Creates a number from its raw representation
+	[[nodiscard]] static constexpr Fixed fromRaw(Storage raw) noexcept
+	{
+		return Fixed(RawTag{}, raw);
+	}
+
+	/// Creates a number from a Q30 value (1.0 = 2^30)
+	[[nodiscard]] static constexpr Fixed fromQ30(int32_t value) noexcept
+	{
+		if constexpr (FRACTION_BITS >= 30)
+		{
+			return fromRaw(static_cast<Storage>(value) << (FRACTION_BITS - 30));
+		}
+		else
+		{
+			constexpr int shift = 30 - FRACTION_BITS;
+			return fromRaw(static_cast<Storage>(
+				(static_cast<int64_t>(value) + (int64_t(1) << (shift - 1))) >> shift));
+		}
+	}
+
+	/// Returns the raw representation
+	[[nodiscard]] constexpr Storage getRaw() const noexcept
+	{
+		return mRaw;
+	}
+
+	/// Returns the angle given in radians as a phase in 1/2^32 turns
+	[[nodiscard]] uint32_t getTurnPhase() const noexcept
+	{
+		// round(2^32 / (2 * pi))
+		constexpr int64_t INV_TWO_PI_Q32 = 683565276;
+		return static_cast<uint32_t>(multiplyShift(mRaw, INV_TWO_PI_Q32, FRACTION_BITS));
+	}
+
+	/// Conversion to float
+	[[nodiscard]] explicit constexpr operator float() const noexcept
+	{
+		return static_cast<float>(static_cast<double>(*this));
+	}
+
+	/// Conversion to double
+	[[nodiscard]] explicit constexpr operator double() const noexcept
+	{
+		return static_cast<double>(mRaw) / static_cast<double>(ONE);
+	}
+
+	/// Negation operator
+	[[nodiscard]] constexpr Fixed operator-() const noexcept
+	{
+		return fromRaw(static_cast<Storage>(0 - static_cast<Unsigned>(mRaw)));
+	}
+
+	/// Addition assignment operator
+	constexpr Fixed& operator+=(Fixed other) noexcept
+	{
+		mRaw = static_cast<Storage>(static_cast<Unsigned>(mRaw) + static_cast<Unsigned>(other.mRaw));
+		return *this;
+	}
+
+	/// Subtraction assignment operator
+	constexpr Fixed& operator-=(Fixed other) noexcept
+	{
+		mRaw = static_cast<Storage>(static_cast<Unsigned>(mRaw) - static_cast<Unsigned>(other.mRaw));
+		return *this;
+	}
+
+	/// Multiplication assignment operator
+	Fixed& operator*=(Fixed other) noexcept
+	{
+		if constexpr (sizeof(Storage) == 4)
+		{
+			const int64_t product = static_cast<int64_t>(mRaw) * other.mRaw +
+				(int64_t(1) << (FRACTION_BITS - 1));
+			mRaw = static_cast<Storage>(product >> FRACTION_BITS);
+		}
+		else
+		{
+			mRaw = multiplyShift(mRaw, other.mRaw, FRACTION_BITS);
+		}
+		return *this;
+	}
+
+	/// Division assignment operator
+	Fixed& operator/=(Fixed other) noexcept
+	{
+		mRaw = divide(mRaw, other.mRaw);
+		return *this;
+	}
+
+	/// Addition operator
+	[[nodiscard]] friend constexpr Fixed operator+(Fixed a, Fixed b) noexcept
+	{
+		return a += b;
+	}
+
+	/// Subtraction operator
+	[[nodiscard]] friend constexpr Fixed operator-(Fixed a, Fixed b) noexcept
+	{
+		return a -= b;
+	}
+
+	/// Multiplication operator
+	[[nodiscard]] friend Fixed operator*(Fixed a, Fixed b) noexcept
+	{
+		return a *= b;
+	}
+
+	/// Division operator
+	[[nodiscard]] friend Fixed operator/(Fixed a, Fixed b) noexcept
+	{
+		return a /= b;
+	}
+
+	/// Equality operator
+	[[nodiscard]] friend constexpr bool operator==(Fixed a, Fixed b) noexcept = default;
+
+	/// Three-way comparison operator
+	[[nodiscard]] friend constexpr auto operator<=>(Fixed a, Fixed b) noexcept = default;
+
+	/// Square root, rounded down; negative values produce 0
+	[[nodiscard]] friend Fixed sqrt(Fixed value) noexcept
+	{
+		if (value.mRaw <= 0)
+		{
+			return fromRaw(0);
+		}
+
+		const uint64_t raw = static_cast<uint64_t>(value.mRaw);
+		if constexpr (sizeof(Storage) == 4)
+		{
+			return fromRaw(static_cast<Storage>(integerSquareRoot(raw << FRACTION_BITS)));
+		}
+		else
+		{
+			// sqrt(raw * 2^F) = sqrt(raw * 2^s) * 2^((F - s) / 2),
+			// with an even s normalizing raw * 2^s to [2^62, 2^64)
+			const int shift = std::countl_zero(raw) & ~1;
+			const uint64_t root = integerSquareRoot(raw << shift);
+			const int scale = (FRACTION_BITS - shift) / 2;
+			return fromRaw(static_cast<Storage>(scale >= 0 ? root << scale : root >> -scale));
+		}
+	}
+
+private:
+	/// Unsigned type for wrap-around arithmetic
+	using Unsigned = std::make_unsigned_t<Storage>;
+
+	/// Tag for the raw constructor
+	struct RawTag
+	{
+	};
+
+	/// Constructor from a raw value
+	constexpr Fixed(RawTag, Storage raw) noexcept :
+		mRaw(raw)
+	{
+	}
+
+	/// Converts an arithmetic value to the raw representation
+	template <typename T>
+	[[nodiscard]] static constexpr Storage toRaw(T value) noexcept
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			return static_cast<Storage>(static_cast<Unsigned>(value) << FRACTION_BITS);
+		}
+		else
+		{
+			// 2^(bits - 1) is exact in double
+			constexpr double LIMIT = static_cast<double>(Unsigned(1) << (sizeof(Storage) * 8 - 1));
+			const double scaled = static_cast<double>(value) * static_cast<double>(ONE);
+			if (!(scaled == scaled))
+			{
+				return 0;
+			}
+			if (scaled >= LIMIT)
+			{
+				return std::numeric_limits<Storage>::max();
+			}
+			if (scaled <= -LIMIT)
+			{
+				return std::numeric_limits<Storage>::min();
+			}
+			return static_cast<Storage>(scaled + (scaled >= 0.0 ? 0.5 : -0.5));
+		}
+	}
+
+	/// Divides raw values with truncation toward zero and saturation
+	[[nodiscard]] static Storage divide(Storage a, Storage b) noexcept
+	{
+		constexpr Storage MAX = std::numeric_limits<Storage>::max();
+		constexpr Storage MIN = std::numeric_limits<Storage>::min();
+		const bool negative = (a < 0) != (b < 0);
+		if (b == 0)
+		{
+			return a == 0 ? 0 : (a > 0 ? MAX : MIN);
+		}
+
+		if constexpr (sizeof(Storage) == 4)
+		{
+			const int64_t quotient = (static_cast<int64_t>(a) * ONE) / b;
+			if (quotient > MAX)
+			{
+				return MAX;
+			}
+			if (quotient < MIN)
+			{
+				return MIN;
+			}
+			return static_cast<Storage>(quotient);
+		}
+		else
+		{
+			const uint64_t magnitudeA = a < 0 ? 0 - static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+			const uint64_t magnitudeB = b < 0 ? 0 - static_cast<uint64_t>(b) : static_cast<uint64_t>(b);
+			const uint64_t high = magnitudeA >> (64 - FRACTION_BITS);
+			const uint64_t low = magnitudeA << FRACTION_BITS;
+			const uint64_t limit = static_cast<uint64_t>(MAX) + negative;
+			if (high >= magnitudeB)
+			{
+				return negative ? MIN : MAX;
+			}
+			const uint64_t quotient = divide128(high, low, magnitudeB);
+			if (quotient >= limit)
+			{
+				return negative ? MIN : MAX;
+			}
+			return static_cast<Storage>(negative ? 0 - quotient : quotient);
+		}
+	}
+
+	/// Raw value, intentionally uninitialized
+	Storage mRaw;
+};
+
+/// 16.16 fixed-point number
+using Fixed32 = Fixed<16, int32_t>;
+
+/// 32.32 fixed-point number
+using Fixed64 = Fixed<32, int64_t>;
+
+} // namespace nph
+
+namespace std
+{
+
+/// Numeric limits of the fixed-point numbers
+template <int FRACTION_BITS, typename Storage>
+class numeric_limits<nph::Fixed<FRACTION_BITS, Storage>>
+{
+	/// The fixed-point type
+	using Type = nph::Fixed<FRACTION_BITS, Storage>;
+
+public:
+	static constexpr bool is_specialized = true;
+	static constexpr bool is_signed = true;
+	static constexpr bool is_integer = false;
+	static constexpr bool is_exact = true;
+	static constexpr int digits = std::numeric_limits<Storage>::digits;
+
+	/// Smallest positive value
+	[[nodiscard]] static constexpr Type min() noexcept
+	{
+		return Type::fromRaw(1);
+	}
+
+	/// Largest value
+	[[nodiscard]] static constexpr Type max() noexcept
+	{
+		return Type::fromRaw(std::numeric_limits<Storage>::max());
+	}
+
+	/// Smallest value
+	[[nodiscard]] static constexpr Type lowest() noexcept
+	{
+		return Type::fromRaw(std::numeric_limits<Storage>::min());
+	}
+
+	/// Resolution of the type
+	[[nodiscard]] static constexpr Type epsilon() noexcept
+	{
+		return Type::fromRaw(1);
+	}
+};
+
+} // namespace std
@@ -106,11 +106,10 @@ inline [[nodiscard]] Mat22 abs(const Mat22& mat) noexcept
 }
 
 /// Returns a rotation matrix for a given angle in radians
-inline [[nodiscard]] Mat22 rotationMat(float angleRad) noexcept
+inline [[nodiscard]] Mat22 rotationMat(Real angleRad) noexcept
 {
-	const float c = std::cos(angleRad);
-	const float s = std::sin(angleRad);
-	return { {c, s}, {-s, c} };
+	const SinCos sc = sinCos(angleRad);
+	return { {sc.cos, sc.sin}, {-sc.sin, sc.cos} };
 }
 
 } // namespace nph
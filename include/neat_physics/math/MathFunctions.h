@@ -0,0 +1,83 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cmath>
+#include "neat_physics/math/FastSinCos.h"
+#include "neat_physics/math/Real.h"
+
+#if !NPH_FIXED_POINT && NPH_DETERMINISTIC && \
+	(defined(_M_X64) || defined(__SSE2__))
+#include <emmintrin.h>
+#endif
+
+namespace nph
+{
+
+/// Sine and cosine of an angle
+using SinCos = BasicSinCos<Real>;
+
+#if !NPH_FIXED_POINT
+/// Portable sine and cosine
+/// The result depends only on IEEE 754 double precision operations and
+/// exact functions (floor, fmod), so it is bit-exact on all platforms.
+/// The error is at most 1 ulp of Real for |angleRad| < 2^20 * pi / 2;
+/// for larger angles the accuracy degrades, but the result stays portable.
+/// NaN and infinite angles produce NaN.
+[[nodiscard]] SinCos portableSinCos(Real angleRad) noexcept;
+#endif
+
+/// Sine and cosine used by the engine, e.g. by Rotation::setAngle
+/// The fixed-point types use the table-based sinTurnsQ30, the deterministic
+/// mode uses portableSinCos, float uses the polynomial fastSinCos
+/// (see NPH_FAST_SIN_COS) and double uses the standard library
+[[nodiscard]] inline SinCos sinCos(Real angleRad) noexcept
+{
+#if NPH_FIXED_POINT
+	// cos(x) = sin(x + pi / 2)
+	const uint32_t phase = angleRad.getTurnPhase();
+	return {
+		Real::fromQ30(sinTurnsQ30(phase)),
+		Real::fromQ30(sinTurnsQ30(phase + (1u << 30))) };
+#elif NPH_DETERMINISTIC
+	return portableSinCos(angleRad);
+#elif NPH_SCALAR == NPH_SCALAR_FLOAT && NPH_FAST_SIN_COS
+	return fastSinCos(angleRad);
+#else
+	return { std::sin(angleRad), std::cos(angleRad) };
+#endif
+}
+
+/// Square root used by the engine
+/// IEEE 754 requires a correctly rounded square root, so it is portable
+/// as long as the compiler does not replace it with an approximation;
+/// the deterministic mode uses the SSE instruction directly where available.
+/// The fixed-point types use an integer square root.
+[[nodiscard]] inline Real squareRoot(Real value) noexcept
+{
+#if NPH_FIXED_POINT
+	return sqrt(value);
+#elif NPH_DETERMINISTIC && (defined(_M_X64) || defined(__SSE2__)) && \
+	NPH_SCALAR == NPH_SCALAR_DOUBLE
+	return _mm_cvtsd_f64(_mm_sqrt_sd(_mm_setzero_pd(), _mm_set_sd(value)));
+#elif NPH_DETERMINISTIC && (defined(_M_X64) || defined(__SSE2__))
+	return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(value)));
+#else
+	return std::sqrt(value);
+#endif
+}
+
+/// Absolute value used by the engine
+[[nodiscard]] inline Real abs(Real value) noexcept
+{
+#if NPH_FIXED_POINT
+	return value < Real(0) ? -value : value;
+#else
+	return std::abs(value);
+#endif
+}
+
+} // namespace nph
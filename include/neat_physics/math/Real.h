@@ -0,0 +1,43 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include "neat_physics/Config.h"
+
+#if NPH_FIXED_POINT
+#include "neat_physics/math/Fixed.h"
+#endif
+
+namespace nph
+{
+
+#if NPH_SCALAR == NPH_SCALAR_FIXED32
+/// Scalar type of the engine
+using Real = Fixed32;
+
+/// Name of the scalar type, e.g. for reports
+inline constexpr const char* REAL_TYPE_NAME = "fixed 16.16";
+#elif NPH_SCALAR == NPH_SCALAR_FIXED64
+/// Scalar type of the engine
+using Real = Fixed64;
+
+/// Name of the scalar type, e.g. for reports
+inline constexpr const char* REAL_TYPE_NAME = "fixed 32.32";
+#elif NPH_SCALAR == NPH_SCALAR_DOUBLE
+/// Scalar type of the engine
+using Real = double;
+
+/// Name of the scalar type, e.g. for reports
+inline constexpr const char* REAL_TYPE_NAME = "double";
+#else
+/// Scalar type of the engine
+using Real = float;
+
+/// Name of the scalar type, e.g. for reports
+inline constexpr const char* REAL_TYPE_NAME = "float";
+#endif
+
+} // namespace nph
@@ -18,20 +18,20 @@ public:
 	Rotation() noexcept = default;
 
 	/// Constructor from angle in radians
-	explicit Rotation(float angleRad) noexcept :
+	explicit Rotation(Real angleRad) noexcept :
 		mAngleRad(angleRad),
 		mMat(rotationMat(mAngleRad))
 	{
 	}
 
 	/// Returns the rotation angle in radians
-	[[nodiscard]] float getAngle() const noexcept
+	[[nodiscard]] Real getAngle() const noexcept
 	{
 		return mAngleRad;
 	}
 
 	/// Sets the rotation angle in radians
-	void setAngle(float angleRad) noexcept
+	void setAngle(Real angleRad) noexcept
 	{
 		mAngleRad = angleRad;
 		mMat = rotationMat(mAngleRad);
@@ -52,7 +52,7 @@ public:
 
 private:
 	/// Angle in radians
-	float mAngleRad;
+	Real mAngleRad;
 
 	/// Rotation matrix
 	Mat22 mMat;
@@ -6,8 +6,11 @@
 
 // Includes
 #include <cassert>
-#include <cmath>
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
+#include <limits>
+#include "neat_physics/math/MathFunctions.h"
 
 namespace nph
 {
@@ -16,67 +19,72 @@ namespace nph
 struct Vec2
 {
 	/// X component, intentionally uninitialized
-	float x;
+	Real x;
 
 	/// Y component, intentionally uninitialized
-	float y;
+	Real y;
 
 	/// Default constructor (no initialization)
 	Vec2() noexcept = default;
 
 	/// Constructor with components
-	constexpr Vec2(float inX, float inY) noexcept :
+	constexpr Vec2(Real inX, Real inY) noexcept :
 		x(inX), y(inY)
 	{
 	}
 
 	/// Sets the vector components
-	void set(float inX, float inY) noexcept
+	void set(Real inX, Real inY) noexcept
 	{
 		x = inX;
 		y = inY;
 	}
 
 	/// Returns the squared length of the vector
-	[[nodiscard]] float lengthSquared() const noexcept
+	[[nodiscard]] Real lengthSquared() const noexcept
 	{
 		return x * x + y * y;
 	}
 
 	/// Returns the length of the vector
-	[[nodiscard]] float length() const noexcept
+	[[nodiscard]] Real length() const noexcept
 	{
-		return std::sqrt(lengthSquared());
+		return squareRoot(lengthSquared());
 	}
 
 	/// Returns a normalized version of the vector, or a zero vector
-	/// if the vector length < FLT_EPSILON
+	/// if the vector length < epsilon of Real
 	[[nodiscard]] Vec2 getNormalized() const noexcept
 	{
-		const float len = length();
-		if (len < FLT_EPSILON)
+		const Real len = length();
+		if (len < std::numeric_limits<Real>::epsilon())
 		{
 			return { 0.0f, 0.0f };
 		}
-		const float invLen = 1.0f / len;
+		const Real invLen = 1.0f / len;
 		return { x * invLen, y * invLen };
 	}
 
 	/// Checks if the vector is normalized
+	/// The tolerance is not below the float one, since the fixed-point
+	/// sine and cosine are accurate only to about 1e-6
 	[[nodiscard]] bool isNormalized() const noexcept
 	{
-		return std::abs(lengthSquared() - 1.0f) < 100.0f * FLT_EPSILON;
+		const Real tolerance = std::max(
+			Real(100.0f * FLT_EPSILON),
+			100.0f * std::numeric_limits<Real>::epsilon());
+		return abs(lengthSquared() - 1.0f) < tolerance;
 	}
 
 	/// Indexing operator (const version)
-	[[nodiscard]] float operator[](int index) const noexcept
+	[[nodiscard]] Real operator[](int index) const noexcept
 	{
 		assert(index < 2);
 		return *(&x + index);
 	}
 
 	/// Indexing operator (non-const version)
-	[[nodiscard]] float& operator[](int index) noexcept
+	[[nodiscard]] Real& operator[](int index) noexcept
 	{
 		assert(index < 2);
 		return *(&x + index);
@@ -105,7 +113,7 @@ struct Vec2
 	}
 
 	/// Scalar multiplication assignment operator
-	Vec2& operator*=(float scalar) noexcept
+	Vec2& operator*=(Real scalar) noexcept
 	{
 		x *= scalar;
 		y *= scalar;
@@ -114,7 +122,7 @@ struct Vec2
 };
 
 /// Dot product of two vectors
-inline [[nodiscard]] float dot(
+inline [[nodiscard]] Real dot(
 	const Vec2& vecA,
 	const Vec2& vecB) noexcept
 {
@@ -123,7 +131,7 @@ inline [[nodiscard]] float dot(
 
 /// Cross product of 2 xy vectors
 /// \return Scalar z-component of the 3D cross product
-inline [[nodiscard]] float cross(
+inline [[nodiscard]] Real cross(
 	const Vec2& xyA,
 	const Vec2& xyB) noexcept
 {
@@ -133,14 +141,14 @@ inline [[nodiscard]] float cross(
 /// Cross product of a xy vector and a z-axis value
 inline [[nodiscard]] Vec2 cross(
 	const Vec2& xy,
-	float z) noexcept
+	Real z) noexcept
 {
 	return { xy.y * z, -xy.x * z };
 }
 
 /// Cross product of a z-axis value and a xy vector
 inline [[nodiscard]] Vec2 cross(
-	float z,
+	Real z,
 	const Vec2& xy) noexcept
 {
 	return { -xy.y * z, xy.x * z };
@@ -167,7 +175,7 @@ inline [[nodiscard]] Vec2 operator-(
 /// intentionally not defined to avoid
 /// optimization flaws like 2.0f * vec * 3.0f
 inline [[nodiscard]] Vec2 operator*(
-	float scalar,
+	Real scalar,
 	const Vec2& vec) noexcept
 {
 	return Vec2(vec) *= scalar;
@@ -176,7 +184,7 @@ inline [[nodiscard]] Vec2 operator*(
 /// Component-wise absolute value of a vector
 inline [[nodiscard]] Vec2 abs(const Vec2& vec) noexcept
 {
-	return { std::abs(vec.x), std::abs(vec.y) };
+	return { abs(vec.x), abs(vec.y) };
 }
 
 } // namespace nph
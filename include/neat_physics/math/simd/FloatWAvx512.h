@@ -0,0 +1,355 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cassert>
+#include <cstdint>
+#include <immintrin.h>
+#include "neat_physics/math/simd/WideTypes.h"
+
+/// AVX-512 (AVX512F) backend of the wide types
+/// \note FMA instructions are intentionally not used,
+/// so the results are equal to the ones of the other backends
+namespace nph::simd::avx512
+{
+
+/// Wide mask, one bit per lane
+class MaskW
+{
+public:
+	/// Number of lanes
+	static constexpr uint32_t WIDTH = 16;
+
+	/// Default constructor (no initialization)
+	MaskW() noexcept = default;
+
+	/// Constructor from a native mask
+	explicit MaskW(__mmask16 value) noexcept :
+		mValue(value)
+	{
+	}
+
+	/// Returns a mask with the first count lanes set
+	[[nodiscard]] static MaskW firstLanes(uint32_t count) noexcept
+	{
+		assert(count <= WIDTH);
+		return MaskW(static_cast<__mmask16>((1u << count) - 1u));
+	}
+
+	/// Returns the native mask
+	[[nodiscard]] __mmask16 getNative() const noexcept
+	{
+		return mValue;
+	}
+
+	/// Returns the lane bits, bit i for lane i
+	[[nodiscard]] uint32_t getBits() const noexcept
+	{
+		return mValue;
+	}
+
+	/// Checks if any lane is set
+	[[nodiscard]] bool any() const noexcept
+	{
+		return mValue != 0;
+	}
+
+	/// Checks if all lanes are set
+	[[nodiscard]] bool all() const noexcept
+	{
+		return mValue == 0xFFFFu;
+	}
+
+	/// Lane-wise AND operator
+	[[nodiscard]] friend MaskW operator&(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(static_cast<__mmask16>(maskA.mValue & maskB.mValue));
+	}
+
+	/// Lane-wise OR operator
+	[[nodiscard]] friend MaskW operator|(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(static_cast<__mmask16>(maskA.mValue | maskB.mValue));
+	}
+
+	/// Lane-wise XOR operator
+	[[nodiscard]] friend MaskW operator^(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(static_cast<__mmask16>(maskA.mValue ^ maskB.mValue));
+	}
+
+	/// Lane-wise NOT operator
+	[[nodiscard]] MaskW operator~() const noexcept
+	{
+		return MaskW(static_cast<__mmask16>(~mValue));
+	}
+
+private:
+	/// Native mask
+	__mmask16 mValue;
+};
+
+/// Wide float, WIDTH lanes
+class FloatW
+{
+public:
+	/// Lane type
+	using Scalar = float;
+
+	/// Mask type
+	using Mask = MaskW;
+
+	/// Number of lanes
+	static constexpr uint32_t WIDTH = MaskW::WIDTH;
+
+	/// Instruction set name
+	static constexpr const char* ISA_NAME = "AVX-512";
+
+	/// Default constructor (no initialization)
+	FloatW() noexcept = default;
+
+	/// Broadcast constructor, sets all lanes to the value
+	FloatW(float value) noexcept :
+		mValue(_mm512_set1_ps(value))
+	{
+	}
+
+	/// Constructor from a native value
+	explicit FloatW(__m512 value) noexcept :
+		mValue(value)
+	{
+	}
+
+	/// Loads WIDTH values, no alignment requirement
+	[[nodiscard]] static FloatW load(const float* data) noexcept
+	{
+		return FloatW(_mm512_loadu_ps(data));
+	}
+
+	/// Stores WIDTH values, no alignment requirement
+	void store(float* data) const noexcept
+	{
+		_mm512_storeu_ps(data, mValue);
+	}
+
+	/// Returns the native value
+	[[nodiscard]] __m512 getNative() const noexcept
+	{
+		return mValue;
+	}
+
+	/// Returns a lane value
+	[[nodiscard]] float getLane(uint32_t index) const noexcept
+	{
+		assert(index < WIDTH);
+		alignas(64) float lanes[WIDTH];
+		_mm512_store_ps(lanes, mValue);
+		return lanes[index];
+	}
+
+	/// Negation operator
+	[[nodiscard]] FloatW operator-() const noexcept
+	{
+		// AVX512F has no float XOR, flip the sign bits as integers
+		return FloatW(_mm512_castsi512_ps(_mm512_xor_si512(
+			_mm512_castps_si512(mValue),
+			_mm512_set1_epi32(static_cast<int>(0x80000000u)))));
+	}
+
+	/// Addition assignment operator
+	FloatW& operator+=(const FloatW& value) noexcept
+	{
+		mValue = _mm512_add_ps(mValue, value.mValue);
+		return *this;
+	}
+
+	/// Subtraction assignment operator
+	FloatW& operator-=(const FloatW& value) noexcept
+	{
+		mValue = _mm512_sub_ps(mValue, value.mValue);
+		return *this;
+	}
+
+	/// Multiplication assignment operator
+	FloatW& operator*=(const FloatW& value) noexcept
+	{
+		mValue = _mm512_mul_ps(mValue, value.mValue);
+		return *this;
+	}
+
+	/// Division assignment operator
+	FloatW& operator/=(const FloatW& value) noexcept
+	{
+		mValue = _mm512_div_ps(mValue, value.mValue);
+		return *this;
+	}
+
+	/// Addition operator
+	[[nodiscard]] friend FloatW operator+(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(_mm512_add_ps(a.mValue, b.mValue));
+	}
+
+	/// Subtraction operator
+	[[nodiscard]] friend FloatW operator-(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(_mm512_sub_ps(a.mValue, b.mValue));
+	}
+
+	/// Multiplication operator
+	[[nodiscard]] friend FloatW operator*(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(_mm512_mul_ps(a.mValue, b.mValue));
+	}
+
+	/// Division operator
+	[[nodiscard]] friend FloatW operator/(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(_mm512_div_ps(a.mValue, b.mValue));
+	}
+
+	/// Less-than comparison
+	[[nodiscard]] friend MaskW operator<(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(_mm512_cmp_ps_mask(a.mValue, b.mValue, _CMP_LT_OQ));
+	}
+
+	/// Less-or-equal comparison
+	[[nodiscard]] friend MaskW operator<=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(_mm512_cmp_ps_mask(a.mValue, b.mValue, _CMP_LE_OQ));
+	}
+
+	/// Greater-than comparison
+	[[nodiscard]] friend MaskW operator>(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(_mm512_cmp_ps_mask(b.mValue, a.mValue, _CMP_LT_OQ));
+	}
+
+	/// Greater-or-equal comparison
+	[[nodiscard]] friend MaskW operator>=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(_mm512_cmp_ps_mask(b.mValue, a.mValue, _CMP_LE_OQ));
+	}
+
+	/// Equality comparison
+	[[nodiscard]] friend MaskW operator==(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(_mm512_cmp_ps_mask(a.mValue, b.mValue, _CMP_EQ_OQ));
+	}
+
+	/// Inequality comparison, set for NaN lanes
+	[[nodiscard]] friend MaskW operator!=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(_mm512_cmp_ps_mask(a.mValue, b.mValue, _CMP_NEQ_UQ));
+	}
+
+	/// Lane-wise minimum, returns b if any of the values is NaN
+	[[nodiscard]] friend FloatW min(const FloatW& a, const FloatW& b) noexcept
+	{
+		return FloatW(_mm512_min_ps(a.mValue, b.mValue));
+	}
+
+	/// Lane-wise maximum, returns b if any of the values is NaN
+	[[nodiscard]] friend FloatW max(const FloatW& a, const FloatW& b) noexcept
+	{
+		return FloatW(_mm512_max_ps(a.mValue, b.mValue));
+	}
+
+	/// Lane-wise absolute value
+	[[nodiscard]] friend FloatW abs(const FloatW& a) noexcept
+	{
+		return FloatW(_mm512_abs_ps(a.mValue));
+	}
+
+	/// Lane-wise square root, correctly rounded
+	[[nodiscard]] friend FloatW sqrt(const FloatW& a) noexcept
+	{
+		return FloatW(_mm512_sqrt_ps(a.mValue));
+	}
+
+	/// Lane-wise fast reciprocal of finite non-zero values,
+	/// see sse2::reciprocal; the AVX-512 estimate has 14 bits
+	[[nodiscard]] friend FloatW reciprocal(const FloatW& a) noexcept
+	{
+#if NPH_DETERMINISTIC
+		return 1.0f / a;
+#else
+		// r' = r * (2 - a * r)
+		const __m512 r = _mm512_rcp14_ps(a.mValue);
+		return FloatW(_mm512_mul_ps(r, _mm512_sub_ps(
+			_mm512_set1_ps(2.0f),
+			_mm512_mul_ps(a.mValue, r))));
+#endif
+	}
+
+	/// Lane-wise fast reciprocal square root of finite positive values,
+	/// see sse2::reciprocalSqrt; the AVX-512 estimate has 14 bits
+	[[nodiscard]] friend FloatW reciprocalSqrt(const FloatW& a) noexcept
+	{
+#if NPH_DETERMINISTIC
+		return 1.0f / sqrt(a);
+#else
+		// r' = 0.5 * r * (3 - a * r * r)
+		const __m512 r = _mm512_rsqrt14_ps(a.mValue);
+		return FloatW(_mm512_mul_ps(
+			_mm512_mul_ps(_mm512_set1_ps(0.5f), r),
+			_mm512_sub_ps(
+				_mm512_set1_ps(3.0f),
+				_mm512_mul_ps(_mm512_mul_ps(a.mValue, r), r))));
+#endif
+	}
+
+	/// Per-lane selection: a where the mask is set, otherwise b
+	[[nodiscard]] friend FloatW select(
+		MaskW mask,
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(_mm512_mask_blend_ps(
+			mask.getNative(),
+			b.mValue,
+			a.mValue));
+	}
+
+private:
+	/// Native value
+	__m512 mValue;
+};
+
+/// Wide vector
+using Vec2W = BasicVec2W<FloatW>;
+
+/// Wide 2x2 matrix
+using Mat22W = BasicMat22W<FloatW>;
+
+/// Wide rotation
+using RotationW = BasicRotationW<FloatW>;
+
+/// Wide body state
+using BodyW = BasicBodyW<FloatW>;
+
+} // namespace nph::simd::avx512
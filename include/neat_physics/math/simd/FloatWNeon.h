@@ -0,0 +1,356 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cassert>
+#include <cstdint>
+#include <arm_neon.h>
+#include "neat_physics/math/simd/WideTypes.h"
+
+/// NEON backend of the wide types (AArch64 only, since the division
+/// and the square root instructions are not available on 32-bit ARM)
+/// \note FMA instructions are intentionally not used,
+/// so the results are equal to the ones of the other backends
+namespace nph::simd::neon
+{
+
+/// Wide mask, all bits of a lane set or cleared
+class MaskW
+{
+public:
+	/// Number of lanes
+	static constexpr uint32_t WIDTH = 4;
+
+	/// Default constructor (no initialization)
+	MaskW() noexcept = default;
+
+	/// Constructor from a native mask
+	explicit MaskW(uint32x4_t value) noexcept :
+		mValue(value)
+	{
+	}
+
+	/// Returns a mask with the first count lanes set
+	[[nodiscard]] static MaskW firstLanes(uint32_t count) noexcept
+	{
+		assert(count <= WIDTH);
+		static constexpr uint32_t LANE_INDICES[WIDTH] = { 0, 1, 2, 3 };
+		return MaskW(vcltq_u32(vld1q_u32(LANE_INDICES), vdupq_n_u32(count)));
+	}
+
+	/// Returns the native mask
+	[[nodiscard]] uint32x4_t getNative() const noexcept
+	{
+		return mValue;
+	}
+
+	/// Returns the lane bits, bit i for lane i
+	[[nodiscard]] uint32_t getBits() const noexcept
+	{
+		static constexpr uint32_t LANE_BITS[WIDTH] = { 1, 2, 4, 8 };
+		return vaddvq_u32(vandq_u32(mValue, vld1q_u32(LANE_BITS)));
+	}
+
+	/// Checks if any lane is set
+	[[nodiscard]] bool any() const noexcept
+	{
+		return vmaxvq_u32(mValue) != 0;
+	}
+
+	/// Checks if all lanes are set
+	[[nodiscard]] bool all() const noexcept
+	{
+		return vminvq_u32(mValue) != 0;
+	}
+
+	/// Lane-wise AND operator
+	[[nodiscard]] friend MaskW operator&(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(vandq_u32(maskA.mValue, maskB.mValue));
+	}
+
+	/// Lane-wise OR operator
+	[[nodiscard]] friend MaskW operator|(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(vorrq_u32(maskA.mValue, maskB.mValue));
+	}
+
+	/// Lane-wise XOR operator
+	[[nodiscard]] friend MaskW operator^(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(veorq_u32(maskA.mValue, maskB.mValue));
+	}
+
+	/// Lane-wise NOT operator
+	[[nodiscard]] MaskW operator~() const noexcept
+	{
+		return MaskW(vmvnq_u32(mValue));
+	}
+
+private:
+	/// Native mask
+	uint32x4_t mValue;
+};
+
+/// Wide float, WIDTH lanes
+class FloatW
+{
+public:
+	/// Lane type
+	using Scalar = float;
+
+	/// Mask type
+	using Mask = MaskW;
+
+	/// Number of lanes
+	static constexpr uint32_t WIDTH = MaskW::WIDTH;
+
+	/// Instruction set name
+	static constexpr const char* ISA_NAME = "NEON";
+
+	/// Default constructor (no initialization)
+	FloatW() noexcept = default;
+
+	/// Broadcast constructor, sets all lanes to the value
+	FloatW(float value) noexcept :
+		mValue(vdupq_n_f32(value))
+	{
+	}
+
+	/// Constructor from a native value
+	explicit FloatW(float32x4_t value) noexcept :
+		mValue(value)
+	{
+	}
+
+	/// Loads WIDTH values, no alignment requirement
+	[[nodiscard]] static FloatW load(const float* data) noexcept
+	{
+		return FloatW(vld1q_f32(data));
+	}
+
+	/// Stores WIDTH values, no alignment requirement
+	void store(float* data) const noexcept
+	{
+		vst1q_f32(data, mValue);
+	}
+
+	/// Returns the native value
+	[[nodiscard]] float32x4_t getNative() const noexcept
+	{
+		return mValue;
+	}
+
+	/// Returns a lane value
+	[[nodiscard]] float getLane(uint32_t index) const noexcept
+	{
+		assert(index < WIDTH);
+		float lanes[WIDTH];
+		vst1q_f32(lanes, mValue);
+		return lanes[index];
+	}
+
+	/// Negation operator
+	[[nodiscard]] FloatW operator-() const noexcept
+	{
+		return FloatW(vnegq_f32(mValue));
+	}
+
+	/// Addition assignment operator
+	FloatW& operator+=(const FloatW& value) noexcept
+	{
+		mValue = vaddq_f32(mValue, value.mValue);
+		return *this;
+	}
+
+	/// Subtraction assignment operator
+	FloatW& operator-=(const FloatW& value) noexcept
+	{
+		mValue = vsubq_f32(mValue, value.mValue);
+		return *this;
+	}
+
+	/// Multiplication assignment operator
+	FloatW& operator*=(const FloatW& value) noexcept
+	{
+		mValue = vmulq_f32(mValue, value.mValue);
+		return *this;
+	}
+
+	/// Division assignment operator
+	FloatW& operator/=(const FloatW& value) noexcept
+	{
+		mValue = vdivq_f32(mValue, value.mValue);
+		return *this;
+	}
+
+	/// Addition operator
+	[[nodiscard]] friend FloatW operator+(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(vaddq_f32(a.mValue, b.mValue));
+	}
+
+	/// Subtraction operator
+	[[nodiscard]] friend FloatW operator-(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(vsubq_f32(a.mValue, b.mValue));
+	}
+
+	/// Multiplication operator
+	[[nodiscard]] friend FloatW operator*(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(vmulq_f32(a.mValue, b.mValue));
+	}
+
+	/// Division operator
+	[[nodiscard]] friend FloatW operator/(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(vdivq_f32(a.mValue, b.mValue));
+	}
+
+	/// Less-than comparison
+	[[nodiscard]] friend MaskW operator<(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(vcltq_f32(a.mValue, b.mValue));
+	}
+
+	/// Less-or-equal comparison
+	[[nodiscard]] friend MaskW operator<=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(vcleq_f32(a.mValue, b.mValue));
+	}
+
+	/// Greater-than comparison
+	[[nodiscard]] friend MaskW operator>(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(vcgtq_f32(a.mValue, b.mValue));
+	}
+
+	/// Greater-or-equal comparison
+	[[nodiscard]] friend MaskW operator>=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(vcgeq_f32(a.mValue, b.mValue));
+	}
+
+	/// Equality comparison
+	[[nodiscard]] friend MaskW operator==(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return MaskW(vceqq_f32(a.mValue, b.mValue));
+	}
+
+	/// Inequality comparison, set for NaN lanes
+	[[nodiscard]] friend MaskW operator!=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return ~(a == b);
+	}
+
+	/// Lane-wise minimum, returns b if any of the values is NaN
+	/// \note vminq_f32 propagates NaN, so the SSE semantics are emulated
+	[[nodiscard]] friend FloatW min(const FloatW& a, const FloatW& b) noexcept
+	{
+		return select(a < b, a, b);
+	}
+
+	/// Lane-wise maximum, returns b if any of the values is NaN
+	/// \note vmaxq_f32 propagates NaN, so the SSE semantics are emulated
+	[[nodiscard]] friend FloatW max(const FloatW& a, const FloatW& b) noexcept
+	{
+		return select(a > b, a, b);
+	}
+
+	/// Lane-wise absolute value
+	[[nodiscard]] friend FloatW abs(const FloatW& a) noexcept
+	{
+		return FloatW(vabsq_f32(a.mValue));
+	}
+
+	/// Lane-wise square root, correctly rounded
+	[[nodiscard]] friend FloatW sqrt(const FloatW& a) noexcept
+	{
+		return FloatW(vsqrtq_f32(a.mValue));
+	}
+
+	/// Lane-wise fast reciprocal of finite non-zero values
+	/// The 8-bit hardware estimate is refined by two Newton-Raphson steps
+	/// to a relative error below 1e-6; the exact division is used
+	/// in the deterministic mode.
+	[[nodiscard]] friend FloatW reciprocal(const FloatW& a) noexcept
+	{
+#if NPH_DETERMINISTIC
+		return 1.0f / a;
+#else
+		// vrecpsq_f32(a, r) = 2 - a * r
+		float32x4_t r = vrecpeq_f32(a.mValue);
+		r = vmulq_f32(r, vrecpsq_f32(a.mValue, r));
+		r = vmulq_f32(r, vrecpsq_f32(a.mValue, r));
+		return FloatW(r);
+#endif
+	}
+
+	/// Lane-wise fast reciprocal square root of finite positive values
+	/// The 8-bit hardware estimate is refined by two Newton-Raphson steps
+	/// to a relative error below 1e-6; the exact operations are used
+	/// in the deterministic mode.
+	[[nodiscard]] friend FloatW reciprocalSqrt(const FloatW& a) noexcept
+	{
+#if NPH_DETERMINISTIC
+		return 1.0f / sqrt(a);
+#else
+		// vrsqrtsq_f32(a * r, r) = (3 - a * r * r) / 2
+		float32x4_t r = vrsqrteq_f32(a.mValue);
+		r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a.mValue, r), r));
+		r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a.mValue, r), r));
+		return FloatW(r);
+#endif
+	}
+
+	/// Per-lane selection: a where the mask is set, otherwise b
+	[[nodiscard]] friend FloatW select(
+		MaskW mask,
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return FloatW(vbslq_f32(mask.getNative(), a.mValue, b.mValue));
+	}
+
+private:
+	/// Native value
+	float32x4_t mValue;
+};
+
+/// Wide vector
+using Vec2W = BasicVec2W<FloatW>;
+
+/// Wide 2x2 matrix
+using Mat22W = BasicMat22W<FloatW>;
+
+/// Wide rotation
+using RotationW = BasicRotationW<FloatW>;
+
+/// Wide body state
+using BodyW = BasicBodyW<FloatW>;
+
+} // namespace nph::simd::neon
@@ -0,0 +1,370 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include "neat_physics/math/simd/WideTypes.h"
+
+/// Scalar emulation of the wide types
+/// It is the reference implementation: all backends produce the same bits
+/// for the same inputs, except for NaN inputs of min / max and for
+/// the approximate reciprocal and reciprocalSqrt (exact here).
+namespace nph::simd::scalar
+{
+
+/// Wide mask, one bit per lane
+class MaskW
+{
+public:
+	/// Number of lanes
+	static constexpr uint32_t WIDTH = 4;
+
+	/// Default constructor (no initialization)
+	MaskW() noexcept = default;
+
+	/// Constructor from lane bits
+	explicit MaskW(uint32_t bits) noexcept :
+		mBits(bits & ALL_BITS)
+	{
+	}
+
+	/// Returns a mask with the first count lanes set
+	[[nodiscard]] static MaskW firstLanes(uint32_t count) noexcept
+	{
+		assert(count <= WIDTH);
+		return MaskW((1u << count) - 1u);
+	}
+
+	/// Returns the lane bits, bit i for lane i
+	[[nodiscard]] uint32_t getBits() const noexcept
+	{
+		return mBits;
+	}
+
+	/// Checks if any lane is set
+	[[nodiscard]] bool any() const noexcept
+	{
+		return mBits != 0;
+	}
+
+	/// Checks if all lanes are set
+	[[nodiscard]] bool all() const noexcept
+	{
+		return mBits == ALL_BITS;
+	}
+
+	/// Lane-wise AND operator
+	[[nodiscard]] friend MaskW operator&(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(maskA.mBits & maskB.mBits);
+	}
+
+	/// Lane-wise OR operator
+	[[nodiscard]] friend MaskW operator|(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(maskA.mBits | maskB.mBits);
+	}
+
+	/// Lane-wise XOR operator
+	[[nodiscard]] friend MaskW operator^(MaskW maskA, MaskW maskB) noexcept
+	{
+		return MaskW(maskA.mBits ^ maskB.mBits);
+	}
+
+	/// Lane-wise NOT operator
+	[[nodiscard]] MaskW operator~() const noexcept
+	{
+		return MaskW(~mBits);
+	}
+
+private:
+	/// All lane bits
+	static constexpr uint32_t ALL_BITS = (1u << WIDTH) - 1u;
+
+	/// Lane bits
+	uint32_t mBits;
+};
+
+/// Wide float, WIDTH lanes
+class FloatW
+{
+public:
+	/// Lane type
+	using Scalar = float;
+
+	/// Mask type
+	using Mask = MaskW;
+
+	/// Number of lanes
+	static constexpr uint32_t WIDTH = MaskW::WIDTH;
+
+	/// Instruction set name
+	static constexpr const char* ISA_NAME = "scalar";
+
+	/// Default constructor (no initialization)
+	FloatW() noexcept = default;
+
+	/// Broadcast constructor, sets all lanes to the value
+	FloatW(float value) noexcept
+	{
+		for (float& lane : mLanes)
+		{
+			lane = value;
+		}
+	}
+
+	/// Loads WIDTH values, no alignment requirement
+	[[nodiscard]] static FloatW load(const float* data) noexcept
+	{
+		FloatW result;
+		for (uint32_t i = 0; i < WIDTH; ++i)
+		{
+			result.mLanes[i] = data[i];
+		}
+		return result;
+	}
+
+	/// Stores WIDTH values, no alignment requirement
+	void store(float* data) const noexcept
+	{
+		for (uint32_t i = 0; i < WIDTH; ++i)
+		{
+			data[i] = mLanes[i];
+		}
+	}
+
+	/// Returns a lane value
+	[[nodiscard]] float getLane(uint32_t index) const noexcept
+	{
+		assert(index < WIDTH);
+		return mLanes[index];
+	}
+
+	/// Negation operator
+	[[nodiscard]] FloatW operator-() const noexcept
+	{
+		return apply([](float a) { return -a; });
+	}
+
+	/// Addition assignment operator
+	FloatW& operator+=(const FloatW& value) noexcept
+	{
+		return *this = *this + value;
+	}
+
+	/// Subtraction assignment operator
+	FloatW& operator-=(const FloatW& value) noexcept
+	{
+		return *this = *this - value;
+	}
+
+	/// Multiplication assignment operator
+	FloatW& operator*=(const FloatW& value) noexcept
+	{
+		return *this = *this * value;
+	}
+
+	/// Division assignment operator
+	FloatW& operator/=(const FloatW& value) noexcept
+	{
+		return *this = *this / value;
+	}
+
+	/// Addition operator
+	[[nodiscard]] friend FloatW operator+(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return apply(a, b, [](float x, float y) { return x + y; });
+	}
+
+	/// Subtraction operator
+	[[nodiscard]] friend FloatW operator-(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return apply(a, b, [](float x, float y) { return x - y; });
+	}
+
+	/// Multiplication operator
+	[[nodiscard]] friend FloatW operator*(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return apply(a, b, [](float x, float y) { return x * y; });
+	}
+
+	/// Division operator
+	[[nodiscard]] friend FloatW operator/(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return apply(a, b, [](float x, float y) { return x / y; });
+	}
+
+	/// Less-than comparison
+	[[nodiscard]] friend MaskW operator<(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return compare(a, b, [](float x, float y) { return x < y; });
+	}
+
+	/// Less-or-equal comparison
+	[[nodiscard]] friend MaskW operator<=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return compare(a, b, [](float x, float y) { return x <= y; });
+	}
+
+	/// Greater-than comparison
+	[[nodiscard]] friend MaskW operator>(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return b < a;
+	}
+
+	/// Greater-or-equal comparison
+	[[nodiscard]] friend MaskW operator>=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return b <= a;
+	}
+
+	/// Equality comparison
+	[[nodiscard]] friend MaskW operator==(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return compare(a, b, [](float x, float y) { return x == y; });
+	}
+
+	/// Inequality comparison, set for NaN lanes
+	[[nodiscard]] friend MaskW operator!=(
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		return ~(a == b);
+	}
+
+	/// Lane-wise minimum
+	/// Like the SSE instruction, returns b if any of the values is NaN
+	[[nodiscard]] friend FloatW min(const FloatW& a, const FloatW& b) noexcept
+	{
+		return apply(a, b, [](float x, float y) { return x < y ? x : y; });
+	}
+
+	/// Lane-wise maximum
+	/// Like the SSE instruction, returns b if any of the values is NaN
+	[[nodiscard]] friend FloatW max(const FloatW& a, const FloatW& b) noexcept
+	{
+		return apply(a, b, [](float x, float y) { return x > y ? x : y; });
+	}
+
+	/// Lane-wise absolute value
+	[[nodiscard]] friend FloatW abs(const FloatW& a) noexcept
+	{
+		return a.apply([](float x) { return std::fabs(x); });
+	}
+
+	/// Lane-wise square root, correctly rounded
+	[[nodiscard]] friend FloatW sqrt(const FloatW& a) noexcept
+	{
+		return a.apply([](float x) { return std::sqrt(x); });
+	}
+
+	/// Lane-wise fast reciprocal, exact in the scalar backend
+	[[nodiscard]] friend FloatW reciprocal(const FloatW& a) noexcept
+	{
+		return 1.0f / a;
+	}
+
+	/// Lane-wise fast reciprocal square root, exact in the scalar backend
+	[[nodiscard]] friend FloatW reciprocalSqrt(const FloatW& a) noexcept
+	{
+		return 1.0f / sqrt(a);
+	}
+
+	/// Per-lane selection: a where the mask is set, otherwise b
+	[[nodiscard]] friend FloatW select(
+		MaskW mask,
+		const FloatW& a,
+		const FloatW& b) noexcept
+	{
+		FloatW result;
+		for (uint32_t i = 0; i < WIDTH; ++i)
+		{
+			result.mLanes[i] =
+				(mask.getBits() >> i) & 1u ? a.mLanes[i] : b.mLanes[i];
+		}
+		return result;
+	}
+
+private:
+	/// Applies a unary function to the lanes
+	template <typename Function>
+	[[nodiscard]] FloatW apply(Function function) const noexcept
+	{
+		FloatW result;
+		for (uint32_t i = 0; i < WIDTH; ++i)
+		{
+			result.mLanes[i] = function(mLanes[i]);
+		}
+		return result;
+	}
+
+	/// Applies a binary function to the lanes
+	template <typename Function>
+	[[nodiscard]] static FloatW apply(
+		const FloatW& a,
+		const FloatW& b,
+		Function function) noexcept
+	{
+		FloatW result;
+		for (uint32_t i = 0; i < WIDTH; ++i)
+		{
+			result.mLanes[i] = function(a.mLanes[i], b.mLanes[i]);
+		}
+		return result;
+	}
+
+	/// Applies a binary predicate to the lanes
+	template <typename Predicate>
+	[[nodiscard]] static MaskW compare(
+		const FloatW& a,
+		const FloatW& b,
+		Predicate predicate) noexcept
+	{
+		uint32_t bits = 0;
+		for (uint32_t i = 0; i < WIDTH; ++i)
+		{
+			bits |= uint32_t(predicate(a.mLanes[i], b.mLanes[i])) << i;
+		}
+		return MaskW(bits);
+	}
+
+	/// Lane values
+	float mLanes[WIDTH];
+};
+
+/// Wide vector
+using Vec2W = BasicVec2W<FloatW>;
+
+/// Wide 2x2 matrix
+using Mat22W = BasicMat22W<FloatW>;
+
+/// Wide rotation
+using RotationW = BasicRotationW<FloatW>;
+
+/// Wide body state
+using BodyW = BasicBodyW<FloatW>;
+
+} // namespace nph::simd::scalar
@@ -0,0 +1,91 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include "neat_physics/Config.h"
+
+/// Instruction sets of the wide (SIMD) types, see NPH_SIMD_ISA
+#define NPH_SIMD_SCALAR 0
+#define NPH_SIMD_SSE2 1
+#define NPH_SIMD_AVX2 2
+#define NPH_SIMD_AVX512 3
+#define NPH_SIMD_NEON 4
+
+/// Instruction set of the wide types in nph::simd::native
+/// By default, the widest instruction set enabled for the translation unit
+/// by the compiler flags (e.g. /arch:AVX2, -mavx2) is selected.
+/// Each instruction set has its own namespace (nph::simd::scalar, sse2,
+/// avx2, avx512, neon), so translation units compiled for different
+/// instruction sets can be linked together. The scalar backend emulates
+/// 4 lanes with plain C++ and is the reference for the others.
+/// All backends produce the same bits as the scalar engine math, except for
+/// the fast reciprocals, provided the compiler does not contract
+/// multiplications and additions into FMA, as in the deterministic mode.
+/// The wide types always use float lanes; the kernels built on them
+/// are meant for NPH_SCALAR_FLOAT.
+#ifndef NPH_SIMD_ISA
+#if defined(__AVX512F__)
+#define NPH_SIMD_ISA NPH_SIMD_AVX512
+#elif defined(__AVX2__)
+#define NPH_SIMD_ISA NPH_SIMD_AVX2
+#elif defined(_M_X64) || defined(__SSE2__) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NPH_SIMD_ISA NPH_SIMD_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define NPH_SIMD_ISA NPH_SIMD_NEON
+#else
+#define NPH_SIMD_ISA NPH_SIMD_SCALAR
+#endif
+#endif
+
+// The scalar backend is always available
+#include "neat_physics/math/simd/FloatWScalar.h"
+
+#if NPH_SIMD_ISA == NPH_SIMD_SCALAR
+
+namespace nph::simd
+{
+namespace native = scalar;
+} // namespace nph::simd
+
+#elif NPH_SIMD_ISA == NPH_SIMD_SSE2
+
+#include "neat_physics/math/simd/FloatWSse2.h"
+namespace nph::simd
+{
+namespace native = sse2;
+} // namespace nph::simd
+
+#elif NPH_SIMD_ISA == NPH_SIMD_AVX2
+
+#include "neat_physics/math/simd/FloatWSse2.h"
+#include "neat_physics/math/simd/FloatWAvx2.h"
+namespace nph::simd
+{
+namespace native = avx2;
+} // namespace nph::simd
+
+#elif NPH_SIMD_ISA == NPH_SIMD_AVX512
+
+#include "neat_physics/math/simd/FloatWSse2.h"
+#include "neat_physics/math/simd/FloatWAvx2.h"
+#include "neat_physics/math/simd/FloatWAvx512.h"
+namespace nph::simd
+{
+namespace native = avx512;
+} // namespace nph::simd
+
+#elif NPH_SIMD_ISA == NPH_SIMD_NEON
+
+#include "neat_physics/math/simd/FloatWNeon.h"
+namespace nph::simd
+{
+namespace native = neon;
+} // namespace nph::simd
+
+#else
+#error "Unknown NPH_SIMD_ISA value"
+#endif
@@ -0,0 +1,380 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include "neat_physics/Body.h"
+
+namespace nph::simd
+{
+
+/// Wide 2-dimensional vector, WIDTH vectors in structure-of-arrays form
+/// The instruction set specific FloatW types define the aliases,
+/// e.g. nph::simd::avx2::Vec2W
+template <typename F>
+struct BasicVec2W
+{
+	/// X components, intentionally uninitialized
+	F x;
+
+	/// Y components, intentionally uninitialized
+	F y;
+
+	/// Default constructor (no initialization)
+	BasicVec2W() noexcept = default;
+
+	/// Constructor with components
+	BasicVec2W(const F& inX, const F& inY) noexcept :
+		x(inX), y(inY)
+	{
+	}
+
+	/// Broadcast constructor, sets all lanes to the vector
+	explicit BasicVec2W(const Vec2& vec) noexcept :
+		x(vec.x), y(vec.y)
+	{
+	}
+
+	/// Returns the vector of a lane
+	[[nodiscard]] Vec2 getLane(uint32_t index) const noexcept
+	{
+		return { x.getLane(index), y.getLane(index) };
+	}
+
+	/// Returns the squared lengths of the vectors
+	[[nodiscard]] F lengthSquared() const noexcept
+	{
+		return x * x + y * y;
+	}
+
+	/// Returns the lengths of the vectors
+	[[nodiscard]] F length() const noexcept
+	{
+		return sqrt(lengthSquared());
+	}
+
+	/// Negation operator
+	[[nodiscard]] BasicVec2W operator-() const noexcept
+	{
+		return { -x, -y };
+	}
+
+	/// Addition assignment operator
+	BasicVec2W& operator+=(const BasicVec2W& vec) noexcept
+	{
+		x += vec.x;
+		y += vec.y;
+		return *this;
+	}
+
+	/// Subtraction assignment operator
+	BasicVec2W& operator-=(const BasicVec2W& vec) noexcept
+	{
+		x -= vec.x;
+		y -= vec.y;
+		return *this;
+	}
+
+	/// Scalar multiplication assignment operator
+	BasicVec2W& operator*=(const F& scalar) noexcept
+	{
+		x *= scalar;
+		y *= scalar;
+		return *this;
+	}
+};
+
+/// Dot products of two wide vectors
+template <typename F>
+inline [[nodiscard]] F dot(
+	const BasicVec2W<F>& vecA,
+	const BasicVec2W<F>& vecB) noexcept
+{
+	return vecA.x * vecB.x + vecA.y * vecB.y;
+}
+
+/// Cross products of 2 wide xy vectors
+template <typename F>
+inline [[nodiscard]] F cross(
+	const BasicVec2W<F>& xyA,
+	const BasicVec2W<F>& xyB) noexcept
+{
+	return xyA.x * xyB.y - xyA.y * xyB.x;
+}
+
+/// Cross products of a wide xy vector and z-axis values
+template <typename F>
+inline [[nodiscard]] BasicVec2W<F> cross(
+	const BasicVec2W<F>& xy,
+	const F& z) noexcept
+{
+	return { xy.y * z, -xy.x * z };
+}
+
+/// Cross products of z-axis values and a wide xy vector
+template <typename F>
+inline [[nodiscard]] BasicVec2W<F> cross(
+	const F& z,
+	const BasicVec2W<F>& xy) noexcept
+{
+	return { -xy.y * z, xy.x * z };
+}
+
+/// Wide vector addition operator
+template <typename F>
+inline [[nodiscard]] BasicVec2W<F> operator+(
+	const BasicVec2W<F>& vecA,
+	const BasicVec2W<F>& vecB) noexcept
+{
+	return BasicVec2W<F>(vecA) += vecB;
+}
+
+/// Wide vector subtraction operator
+template <typename F>
+inline [[nodiscard]] BasicVec2W<F> operator-(
+	const BasicVec2W<F>& vecA,
+	const BasicVec2W<F>& vecB) noexcept
+{
+	return BasicVec2W<F>(vecA) -= vecB;
+}
+
+/// Scalar multiplication operator
+/// \note like for Vec2, the vector-scalar operator is intentionally not defined
+template <typename F>
+inline [[nodiscard]] BasicVec2W<F> operator*(
+	const F& scalar,
+	const BasicVec2W<F>& vec) noexcept
+{
+	return BasicVec2W<F>(vec) *= scalar;
+}
+
+/// Component-wise absolute value of a wide vector
+template <typename F>
+inline [[nodiscard]] BasicVec2W<F> abs(const BasicVec2W<F>& vec) noexcept
+{
+	return { abs(vec.x), abs(vec.y) };
+}
+
+/// Per-lane selection: vecA where the mask is set, otherwise vecB
+template <typename F>
+inline [[nodiscard]] BasicVec2W<F> select(
+	const typename F::Mask& mask,
+	const BasicVec2W<F>& vecA,
+	const BasicVec2W<F>& vecB) noexcept
+{
+	return { select(mask, vecA.x, vecB.x), select(mask, vecA.y, vecB.y) };
+}
+
+/// Wide 2x2 matrix, WIDTH matrices in structure-of-arrays form
+template <typename F>
+struct BasicMat22W
+{
+	/// First column
+	BasicVec2W<F> col1;
+
+	/// Second column
+	BasicVec2W<F> col2;
+
+	/// Default constructor (no initialization)
+	BasicMat22W() noexcept = default;
+
+	/// Constructor with columns
+	BasicMat22W(
+		const BasicVec2W<F>& inCol1,
+		const BasicVec2W<F>& inCol2) noexcept :
+		col1(inCol1),
+		col2(inCol2)
+	{
+	}
+
+	/// Broadcast constructor, sets all lanes to the matrix
+	explicit BasicMat22W(const Mat22& mat) noexcept :
+		col1(mat.col1),
+		col2(mat.col2)
+	{
+	}
+
+	/// Returns the transposed matrices
+	[[nodiscard]] BasicMat22W getTransposed() const noexcept
+	{
+		return { { col1.x, col2.x }, { col1.y, col2.y } };
+	}
+};
+
+/// Wide matrix-vector multiplication operator
+template <typename F>
+inline [[nodiscard]] BasicVec2W<F> operator*(
+	const BasicMat22W<F>& mat,
+	const BasicVec2W<F>& vec) noexcept
+{
+	return {
+		mat.col1.x * vec.x + mat.col2.x * vec.y,
+		mat.col1.y * vec.x + mat.col2.y * vec.y };
+}
+
+/// Wide 2D rotation, stored as cosines and sines of the angles
+/// Unlike Rotation, the angles are not stored: the kernels read and write
+/// them separately, see BasicBodyW
+template <typename F>
+struct BasicRotationW
+{
+	/// Cosines of the angles
+	F cos;
+
+	/// Sines of the angles
+	F sin;
+
+	/// Returns the rotation matrices, equal to the ones of Rotation::getMat()
+	[[nodiscard]] BasicMat22W<F> getMat() const noexcept
+	{
+		return { { cos, sin }, { -sin, cos } };
+	}
+
+	/// Rotates the vectors, equal to Rotation::getMat() * vec
+	[[nodiscard]] BasicVec2W<F> rotate(const BasicVec2W<F>& vec) const noexcept
+	{
+		return { cos * vec.x - sin * vec.y, sin * vec.x + cos * vec.y };
+	}
+
+	/// Rotates the vectors backwards, equal to Rotation::getInverseMat() * vec
+	[[nodiscard]] BasicVec2W<F> inverseRotate(
+		const BasicVec2W<F>& vec) const noexcept
+	{
+		return { cos * vec.x + sin * vec.y, cos * vec.y - sin * vec.x };
+	}
+};
+
+/// State of WIDTH bodies, one body per lane
+/// The bodies are gathered from and scattered to a body array by indices,
+/// so the kernels can process e.g. the body pairs of contacts.
+/// The wide types use float lanes, so the struct requires NPH_SCALAR_FLOAT.
+template <typename F>
+struct BasicBodyW
+{
+	/// Positions
+	BasicVec2W<F> position;
+
+	/// Rotation angles in radians
+	F angle;
+
+	/// Rotations
+	BasicRotationW<F> rotation;
+
+	/// Linear velocities
+	BasicVec2W<F> linearVelocity;
+
+	/// Angular velocities
+	F angularVelocity;
+
+	/// Inverse masses
+	F invMass;
+
+	/// Inverse moments of inertia
+	F invInertia;
+
+	/// Gathers the bodies with the given indices
+	/// \param bodies Body array
+	/// \param indices Indices of the bodies in the array, count values
+	/// \param count Number of bodies to gather; must be <= WIDTH.
+	/// The lanes >= count are filled as static bodies at rest at the origin.
+	[[nodiscard]] static BasicBodyW gather(
+		const Body* bodies,
+		const uint32_t* indices,
+		uint32_t count) noexcept
+	{
+		static_assert(
+			std::is_same_v<typename F::Scalar, Real>,
+			"The wide body types require NPH_SCALAR_FLOAT");
+		assert(count <= F::WIDTH);
+
+		alignas(64) float lanes[10][F::WIDTH] = {};
+		for (uint32_t i = 0; i < F::WIDTH; ++i)
+		{
+			if (i >= count)
+			{
+				lanes[3][i] = 1.0f;
+				continue;
+			}
+
+			const Body& body = bodies[indices[i]];
+			const Mat22& mat = body.rotation.getMat();
+			lanes[0][i] = static_cast<float>(body.position.x);
+			lanes[1][i] = static_cast<float>(body.position.y);
+			lanes[2][i] = static_cast<float>(body.rotation.getAngle());
+			lanes[3][i] = static_cast<float>(mat.col1.x);
+			lanes[4][i] = static_cast<float>(mat.col1.y);
+			lanes[5][i] = static_cast<float>(body.linearVelocity.x);
+			lanes[6][i] = static_cast<float>(body.linearVelocity.y);
+			lanes[7][i] = static_cast<float>(body.angularVelocity);
+			lanes[8][i] = static_cast<float>(body.invMass);
+			lanes[9][i] = static_cast<float>(body.invInertia);
+		}
+
+		BasicBodyW result;
+		result.position = { F::load(lanes[0]), F::load(lanes[1]) };
+		result.angle = F::load(lanes[2]);
+		result.rotation = { F::load(lanes[3]), F::load(lanes[4]) };
+		result.linearVelocity = { F::load(lanes[5]), F::load(lanes[6]) };
+		result.angularVelocity = F::load(lanes[7]);
+		result.invMass = F::load(lanes[8]);
+		result.invInertia = F::load(lanes[9]);
+		return result;
+	}
+
+	/// Scatters the velocities of the first count lanes to the bodies
+	/// \param bodies Body array
+	/// \param indices Indices of the bodies in the array, count values;
+	/// must be unique, otherwise the last lane wins
+	/// \param count Number of bodies to scatter; must be <= WIDTH
+	void scatterVelocities(
+		Body* bodies,
+		const uint32_t* indices,
+		uint32_t count) const noexcept
+	{
+		assert(count <= F::WIDTH);
+
+		alignas(64) float lanes[3][F::WIDTH];
+		linearVelocity.x.store(lanes[0]);
+		linearVelocity.y.store(lanes[1]);
+		angularVelocity.store(lanes[2]);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Body& body = bodies[indices[i]];
+			body.linearVelocity.set(lanes[0][i], lanes[1][i]);
+			body.angularVelocity = lanes[2][i];
+		}
+	}
+
+	/// Scatters the positions and the angles of the first count lanes
+	/// to the bodies; the rotation matrices are recomputed from the angles
+	/// by Rotation::setAngle, the rotation member is not used
+	/// \param bodies Body array
+	/// \param indices Indices of the bodies in the array, count values;
+	/// must be unique, otherwise the last lane wins
+	/// \param count Number of bodies to scatter; must be <= WIDTH
+	void scatterPositions(
+		Body* bodies,
+		const uint32_t* indices,
+		uint32_t count) const noexcept
+	{
+		assert(count <= F::WIDTH);
+
+		alignas(64) float lanes[3][F::WIDTH];
+		position.x.store(lanes[0]);
+		position.y.store(lanes[1]);
+		angle.store(lanes[2]);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Body& body = bodies[indices[i]];
+			body.position.set(lanes[0][i], lanes[1][i]);
+			body.rotation.setAngle(lanes[2][i]);
+		}
+	}
+};
+
+} // namespace nph::simd
@@ -0,0 +1,54 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+namespace nph
+{
+
+/// Writes a trivially copyable value to a binary stream
+template <typename T>
+void writeValue(std::ostream& stream, const T& value)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// Reads a trivially copyable value from a binary stream
+/// \return true on success
+template <typename T>
+[[nodiscard]] bool readValue(std::istream& stream, T& value)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	return static_cast<bool>(
+		stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/// Writes an array of trivially copyable values to a binary stream
+template <typename T>
+void writeArray(std::ostream& stream, const T* data, size_t count)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	stream.write(
+		reinterpret_cast<const char*>(data),
+		static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+/// Reads an array of trivially copyable values from a binary stream
+/// \return true on success
+template <typename T>
+[[nodiscard]] bool readArray(std::istream& stream, T* data, size_t count)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	return static_cast<bool>(stream.read(
+		reinterpret_cast<char*>(data),
+		static_cast<std::streamsize>(count * sizeof(T))));
+}
+
+} // namespace nph
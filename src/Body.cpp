@@ -11,7 +11,7 @@ namespace
 {
 
 /// Returns the moment of inertia for a box shape
-float getBoxInertia(const Vec2& size, float mass)
+Real getBoxInertia(const Vec2& size, Real mass)
 {
 	return mass * size.lengthSquared() / 12.0f;
 }
@@ -20,8 +20,8 @@ float getBoxInertia(const Vec2& size, float mass)
 
 Body::Body(
 	const Vec2& inSize,
-	float inMass,
-	float inFriction) :
+	Real inMass,
+	Real inFriction) :
 
 	halfSize(0.5f * inSize),
 
@@ -0,0 +1,211 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "neat_physics/RollbackBuffer.h"
+#include <cstring>
+
+namespace nph
+{
+
+bool RollbackBuffer::BodyState::operator==(const BodyState& other) const noexcept
+{
+	static_assert(sizeof(BodyState) == 6 * sizeof(Real), "Unexpected padding");
+	return std::memcmp(this, &other, sizeof(BodyState)) == 0;
+}
+
+RollbackBuffer::RollbackBuffer(
+	uint32_t capacity,
+	uint32_t keyframeInterval) :
+
+	mStates(capacity),
+	mKeyframeInterval(keyframeInterval)
+{
+	assert(mKeyframeInterval > 0);
+}
+
+uint32_t RollbackBuffer::getMaxStepsBack() const noexcept
+{
+	// States older than the oldest keyframe can not be restored
+	for (uint32_t stepsBack = mCount; stepsBack-- > 0;)
+	{
+		if (mStates[getStateIndex(stepsBack)].isKeyframe)
+		{
+			return stepsBack;
+		}
+	}
+	return 0;
+}
+
+size_t RollbackBuffer::getMemoryUsage() const noexcept
+{
+	size_t result = mLastBodyStates.capacity() * sizeof(BodyState);
+	for (const State& state : mStates)
+	{
+		result +=
+			sizeof(State) +
+			state.changedBodies.capacity() * sizeof(uint32_t) +
+			state.bodyStates.capacity() * sizeof(BodyState) +
+			state.endpoints.capacity() * sizeof(BroadPhase::Endpoint) +
+			state.manifolds.capacity() * sizeof(ContactSolver::ManifoldRecord);
+	}
+	return result;
+}
+
+void RollbackBuffer::clear() noexcept
+{
+	mNewest = 0;
+	mCount = 0;
+	mLastBodyStates.clear();
+}
+
+void RollbackBuffer::save(
+	const BodyArray& bodies,
+	const BroadPhase& broadPhase,
+	const ContactSolver& contactSolver)
+{
+	if (mStates.empty())
+	{
+		return;
+	}
+
+	// Number of states since the newest keyframe
+	uint32_t deltaCount = 0;
+	while (deltaCount < mCount &&
+		!mStates[getStateIndex(deltaCount)].isKeyframe)
+	{
+		++deltaCount;
+	}
+
+	const size_t oldBodyCount = mLastBodyStates.size();
+	const bool isKeyframe =
+		deltaCount == mCount ||
+		deltaCount + 1 >= mKeyframeInterval ||
+		bodies.size() < oldBodyCount;
+
+	mNewest = (mNewest + 1) % getCapacity();
+	mCount = std::min(mCount + 1, getCapacity());
+
+	State& state = mStates[mNewest];
+	state.bodyCount = static_cast<uint32_t>(bodies.size());
+	state.isKeyframe = isKeyframe;
+	state.changedBodies.clear();
+	state.bodyStates.clear();
+
+	mLastBodyStates.resize(bodies.size());
+	for (uint32_t i = 0; i < state.bodyCount; ++i)
+	{
+		const Body& body = bodies[i];
+		if (body.isStatic())
+		{
+			continue;
+		}
+
+		const BodyState bodyState{
+			body.position,
+			body.rotation.getAngle(),
+			body.linearVelocity,
+			body.angularVelocity };
+
+		if (isKeyframe)
+		{
+			state.bodyStates.push_back(bodyState);
+		}
+		else if (i >= oldBodyCount || !(bodyState == mLastBodyStates[i]))
+		{
+			state.changedBodies.push_back(i);
+			state.bodyStates.push_back(bodyState);
+		}
+		mLastBodyStates[i] = bodyState;
+	}
+
+	state.endpoints = broadPhase.getEndpoints();
+	contactSolver.getManifoldRecords(state.manifolds);
+}
+
+bool RollbackBuffer::restore(
+	uint32_t stepsBack,
+	BodyArray& bodies,
+	BroadPhase& broadPhase,
+	ContactSolver& contactSolver)
+{
+	if (mCount == 0 || stepsBack > getMaxStepsBack())
+	{
+		return false;
+	}
+
+	const State& target = mStates[getStateIndex(stepsBack)];
+	if (bodies.size() < target.bodyCount)
+	{
+		return false;
+	}
+
+	// Rebuild the full body states from the keyframe and the following deltas
+	uint32_t keyframeStepsBack = stepsBack;
+	while (!mStates[getStateIndex(keyframeStepsBack)].isKeyframe)
+	{
+		++keyframeStepsBack;
+	}
+
+	const State& keyframe = mStates[getStateIndex(keyframeStepsBack)];
+	mLastBodyStates.resize(keyframe.bodyCount);
+	auto keyframeState = keyframe.bodyStates.begin();
+	for (uint32_t i = 0; i < keyframe.bodyCount; ++i)
+	{
+		if (!bodies[i].isStatic())
+		{
+			mLastBodyStates[i] = *keyframeState++;
+		}
+	}
+
+	for (uint32_t deltaStepsBack = keyframeStepsBack;
+		deltaStepsBack-- > stepsBack;)
+	{
+		const State& delta = mStates[getStateIndex(deltaStepsBack)];
+		mLastBodyStates.resize(delta.bodyCount);
+		for (size_t ci = 0; ci < delta.changedBodies.size(); ++ci)
+		{
+			mLastBodyStates[delta.changedBodies[ci]] = delta.bodyStates[ci];
+		}
+	}
+
+	// Remove the bodies added after the target state
+	while (bodies.size() > target.bodyCount)
+	{
+		bodies.pop_back();
+	}
+
+	for (uint32_t i = 0; i < target.bodyCount; ++i)
+	{
+		Body& body = bodies[i];
+		if (!body.isStatic())
+		{
+			const BodyState& bodyState = mLastBodyStates[i];
+			body.position = bodyState.position;
+			body.rotation.setAngle(bodyState.angle);
+			body.linearVelocity = bodyState.linearVelocity;
+			body.angularVelocity = bodyState.angularVelocity;
+		}
+	}
+
+	if (!broadPhase.setEndpoints(target.endpoints) ||
+		!contactSolver.setManifolds(target.manifolds))
+	{
+		clear();
+		return false;
+	}
+
+	// Discard the newer states, they will be recorded again on resimulation
+	mNewest = getStateIndex(stepsBack);
+	mCount -= stepsBack;
+	return true;
+}
+
+uint32_t RollbackBuffer::getStateIndex(uint32_t stepsBack) const noexcept
+{
+	assert(stepsBack < mCount);
+	return (mNewest + getCapacity() - stepsBack) % getCapacity();
+}
+
+} // namespace nph
@@ -0,0 +1,359 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "neat_physics/StateEncoder.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include "neat_physics/World.h"
+
+namespace nph
+{
+
+namespace
+{
+
+/// Packet flag: the baseline is reset, the deltas are relative to zero
+constexpr uint8_t RESET_BASELINE_FLAG = 1;
+
+/// Maximum number of bytes of a varint of uint64_t
+constexpr uint32_t MAX_VARINT_SIZE = 10;
+
+/// Returns the mask of the quantized angle
+[[nodiscard]] uint32_t getAngleMask(uint32_t angleBits) noexcept
+{
+	assert(angleBits >= 2 && angleBits <= 32);
+	return angleBits == 32 ?
+		std::numeric_limits<uint32_t>::max() :
+		(1u << angleBits) - 1u;
+}
+
+/// Quantizes a coordinate clamping it to the int32_t range; NaN is mapped to 0
+[[nodiscard]] int32_t quantizeCoordinate(Real value, float precision) noexcept
+{
+	const double scaled = std::round(static_cast<double>(value) / precision);
+	if (!(scaled == scaled))
+	{
+		return 0;
+	}
+	return static_cast<int32_t>(std::clamp(
+		scaled,
+		static_cast<double>(std::numeric_limits<int32_t>::min()),
+		static_cast<double>(std::numeric_limits<int32_t>::max())));
+}
+
+/// Maps a signed value to an unsigned one with small magnitudes
+/// mapped to small values: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+[[nodiscard]] uint64_t encodeZigzag(int64_t value) noexcept
+{
+	return (static_cast<uint64_t>(value) << 1) ^
+		static_cast<uint64_t>(value >> 63);
+}
+
+/// Inverse of encodeZigzag
+[[nodiscard]] int64_t decodeZigzag(uint64_t value) noexcept
+{
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/// Appends a value as a varint: 7 bits per byte, the high bit marks continuation
+void writeVarint(std::vector<uint8_t>& output, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		output.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	output.push_back(static_cast<uint8_t>(value));
+}
+
+/// Sequential reader of a packet
+class PacketReader
+{
+public:
+	/// Constructor
+	explicit PacketReader(std::span<const uint8_t> packet) noexcept :
+		mPacket(packet)
+	{
+	}
+
+	/// Reads a byte
+	/// \return true on success
+	[[nodiscard]] bool readByte(uint8_t& value) noexcept
+	{
+		if (mPosition == mPacket.size())
+		{
+			return false;
+		}
+		value = mPacket[mPosition++];
+		return true;
+	}
+
+	/// Reads a varint
+	/// \return true on success
+	[[nodiscard]] bool readVarint(uint64_t& value) noexcept
+	{
+		value = 0;
+		for (uint32_t i = 0; i < MAX_VARINT_SIZE; ++i)
+		{
+			uint8_t byte;
+			if (!readByte(byte))
+			{
+				return false;
+			}
+			value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+			if ((byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/// Checks if the whole packet has been read
+	[[nodiscard]] bool isAtEnd() const noexcept
+	{
+		return mPosition == mPacket.size();
+	}
+
+private:
+	/// Packet
+	std::span<const uint8_t> mPacket;
+
+	/// Read position
+	size_t mPosition{ 0 };
+};
+
+} // anonymous namespace
+
+QuantizedTransform StateQuantization::quantize(
+	const Vec2& position,
+	Real angle) const noexcept
+{
+	assert(positionPrecision > 0.0f);
+	const uint32_t angleMask = getAngleMask(angleBits);
+
+	// Map the angle to [0, 1) turns, the rounding up to a full turn
+	// is wrapped to 0 by the mask
+	const double turns = static_cast<double>(angle) / (2.0 * std::numbers::pi);
+	const double fraction = turns - std::floor(turns);
+	const double scaledAngle = std::round(fraction * (static_cast<double>(angleMask) + 1.0));
+
+	return {
+		quantizeCoordinate(position.x, positionPrecision),
+		quantizeCoordinate(position.y, positionPrecision),
+		(fraction == fraction) ?
+			static_cast<uint32_t>(static_cast<uint64_t>(scaledAngle) & angleMask) :
+			0 };
+}
+
+BodyTransform StateQuantization::dequantize(
+	const QuantizedTransform& transform) const noexcept
+{
+	const double angleScale =
+		2.0 * std::numbers::pi / (static_cast<double>(getAngleMask(angleBits)) + 1.0);
+
+	return {
+		{
+			static_cast<Real>(transform.x * static_cast<double>(positionPrecision)),
+			static_cast<Real>(transform.y * static_cast<double>(positionPrecision))
+		},
+		static_cast<Real>(transform.angle * angleScale) };
+}
+
+StateEncoder::StateEncoder(const StateQuantization& quantization) :
+	mQuantization(quantization)
+{
+	assert(mQuantization.positionPrecision > 0.0f);
+	assert(mQuantization.angleBits >= 2 && mQuantization.angleBits <= 32);
+}
+
+uint32_t StateEncoder::encode(
+	const BodyArray& bodies,
+	std::vector<uint8_t>& output)
+{
+	const uint32_t bodyCount = static_cast<uint32_t>(bodies.size());
+	const uint32_t angleMask = getAngleMask(mQuantization.angleBits);
+	const uint32_t halfAngleRange = angleMask / 2 + 1;
+
+	// The bodies added since the previous packet have the zero baseline,
+	// the decoder does the same
+	if (mIsBaselineReset)
+	{
+		mBaseline.assign(bodyCount, {});
+	}
+	else
+	{
+		mBaseline.resize(bodyCount, {});
+	}
+
+	uint32_t changedCount = 0;
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		const Body& body = bodies[i];
+		if (mQuantization.quantize(body.position, body.rotation.getAngle()) !=
+			mBaseline[i])
+		{
+			++changedCount;
+		}
+	}
+
+	output.push_back(mIsBaselineReset ? RESET_BASELINE_FLAG : 0);
+	writeVarint(output, bodyCount);
+	writeVarint(output, changedCount);
+
+	uint32_t nextIndex = 0;
+	for (uint32_t i = 0; i < bodyCount && changedCount != 0; ++i)
+	{
+		const Body& body = bodies[i];
+		const QuantizedTransform transform =
+			mQuantization.quantize(body.position, body.rotation.getAngle());
+
+		QuantizedTransform& baseline = mBaseline[i];
+		if (transform == baseline)
+		{
+			continue;
+		}
+
+		// The angle delta is wrapped to the shortest direction
+		const uint32_t angleDelta = (transform.angle - baseline.angle) & angleMask;
+		const int64_t signedAngleDelta = angleDelta >= halfAngleRange ?
+			static_cast<int64_t>(angleDelta) - (static_cast<int64_t>(angleMask) + 1) :
+			static_cast<int64_t>(angleDelta);
+
+		writeVarint(output, i - nextIndex);
+		writeVarint(output, encodeZigzag(static_cast<int64_t>(transform.x) - baseline.x));
+		writeVarint(output, encodeZigzag(static_cast<int64_t>(transform.y) - baseline.y));
+		writeVarint(output, encodeZigzag(signedAngleDelta));
+
+		baseline = transform;
+		nextIndex = i + 1;
+	}
+
+	mIsBaselineReset = false;
+	return changedCount;
+}
+
+void StateEncoder::resetBaseline() noexcept
+{
+	mIsBaselineReset = true;
+}
+
+StateDecoder::StateDecoder(
+	const StateQuantization& quantization,
+	uint32_t maxBodyCount) :
+
+	mQuantization(quantization),
+	mMaxBodyCount(maxBodyCount)
+{
+	assert(mQuantization.positionPrecision > 0.0f);
+	assert(mQuantization.angleBits >= 2 && mQuantization.angleBits <= 32);
+	assert(mMaxBodyCount > 0);
+}
+
+bool StateDecoder::decode(std::span<const uint8_t> packet)
+{
+	const uint32_t angleMask = getAngleMask(mQuantization.angleBits);
+
+	PacketReader reader(packet);
+	uint8_t flags;
+	uint64_t bodyCount;
+	uint64_t changedCount;
+	if (!reader.readByte(flags) ||
+		(flags & ~RESET_BASELINE_FLAG) != 0 ||
+		!reader.readVarint(bodyCount) ||
+		!reader.readVarint(changedCount) ||
+		bodyCount > mMaxBodyCount ||
+		changedCount > bodyCount)
+	{
+		return false;
+	}
+
+	const bool isBaselineReset = (flags & RESET_BASELINE_FLAG) != 0;
+
+	// Read the whole packet before changing the state
+	mChangedBodies.clear();
+	mChangedTransforms.clear();
+	uint64_t nextIndex = 0;
+	for (uint64_t c = 0; c < changedCount; ++c)
+	{
+		uint64_t indexGap;
+		uint64_t dx;
+		uint64_t dy;
+		uint64_t angleDelta;
+		if (!reader.readVarint(indexGap) ||
+			!reader.readVarint(dx) ||
+			!reader.readVarint(dy) ||
+			!reader.readVarint(angleDelta) ||
+			indexGap >= bodyCount - nextIndex)
+		{
+			return false;
+		}
+
+		const uint32_t index = static_cast<uint32_t>(nextIndex + indexGap);
+		const QuantizedTransform baseline =
+			(isBaselineReset || index >= mQuantized.size()) ?
+			QuantizedTransform{} :
+			mQuantized[index];
+
+		const int64_t x = baseline.x + decodeZigzag(dx);
+		const int64_t y = baseline.y + decodeZigzag(dy);
+		if (x < std::numeric_limits<int32_t>::min() ||
+			x > std::numeric_limits<int32_t>::max() ||
+			y < std::numeric_limits<int32_t>::min() ||
+			y > std::numeric_limits<int32_t>::max())
+		{
+			return false;
+		}
+
+		mChangedBodies.push_back(index);
+		mChangedTransforms.push_back({
+			static_cast<int32_t>(x),
+			static_cast<int32_t>(y),
+			(baseline.angle + static_cast<uint32_t>(decodeZigzag(angleDelta))) & angleMask });
+		nextIndex = static_cast<uint64_t>(index) + 1;
+	}
+
+	if (!reader.isAtEnd())
+	{
+		return false;
+	}
+
+	const BodyTransform zeroTransform = mQuantization.dequantize({});
+	if (isBaselineReset)
+	{
+		mQuantized.assign(bodyCount, {});
+		mTransforms.assign(bodyCount, zeroTransform);
+	}
+	else
+	{
+		mQuantized.resize(bodyCount, {});
+		mTransforms.resize(bodyCount, zeroTransform);
+	}
+
+	for (size_t i = 0; i < mChangedBodies.size(); ++i)
+	{
+		const uint32_t index = mChangedBodies[i];
+		mQuantized[index] = mChangedTransforms[i];
+		mTransforms[index] = mQuantization.dequantize(mChangedTransforms[i]);
+	}
+	return true;
+}
+
+bool StateDecoder::apply(World& world) const
+{
+	if (world.getBodies().size() != mTransforms.size())
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < mTransforms.size(); ++i)
+	{
+		world.setBodyTransform(i, mTransforms[i].position, mTransforms[i].angle);
+	}
+	return true;
+}
+
+} // namespace nph
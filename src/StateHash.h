@@ -0,0 +1,82 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include <bit>
+#include <type_traits>
+#include "neat_physics/Body.h"
+#include "neat_physics/dynamics/ContactManifold.h"
+
+namespace nph
+{
+
+/// Scrambles the bits of a 64-bit value (the SplitMix64 finalizer)
+[[nodiscard]] inline uint64_t mixHash(uint64_t value) noexcept
+{
+	value ^= value >> 30;
+	value *= 0xBF58476D1CE4E5B9ull;
+	value ^= value >> 27;
+	value *= 0x94D049BB133111EBull;
+	value ^= value >> 31;
+	return value;
+}
+
+/// Unsigned integer type with the bits of Real
+using RealBits = std::conditional_t<sizeof(Real) == sizeof(uint32_t), uint32_t, uint64_t>;
+
+/// Mixes the bits of two scalars into a hash;
+/// 32-bit scalars are packed into a single 64-bit value
+[[nodiscard]] inline uint64_t mixRealBits(
+	uint64_t hash,
+	Real first,
+	Real second) noexcept
+{
+	if constexpr (sizeof(Real) == sizeof(uint32_t))
+	{
+		return mixHash(hash ^ (static_cast<uint64_t>(std::bit_cast<RealBits>(first)) |
+			(static_cast<uint64_t>(std::bit_cast<RealBits>(second)) << 32)));
+	}
+	else
+	{
+		hash = mixHash(hash ^ std::bit_cast<RealBits>(first));
+		return mixHash(hash ^ std::bit_cast<RealBits>(second));
+	}
+}
+
+/// Returns the hash of the bit-exact state of a body;
+/// the hashes of the bodies are combined by wrapping addition,
+/// so they can be updated and combined in any order
+[[nodiscard]] inline uint64_t hashBodyState(
+	uint32_t bodyIndex,
+	const Body& body) noexcept
+{
+	uint64_t hash = mixHash(bodyIndex + 0x9E3779B97F4A7C15ull);
+	hash = mixRealBits(hash, body.position.x, body.position.y);
+	hash = mixRealBits(hash, body.rotation.getAngle(), body.angularVelocity);
+	hash = mixRealBits(hash, body.linearVelocity.x, body.linearVelocity.y);
+	return hash;
+}
+
+/// Returns the hash of a persistent contact manifold:
+/// the body pair, the contact features and the accumulated impulses
+[[nodiscard]] inline uint64_t hashContactManifold(
+	uint64_t bodyPairKey,
+	const ContactManifold& manifold) noexcept
+{
+	uint64_t hash = mixHash(bodyPairKey ^ manifold.getContactCount());
+	for (uint32_t i = 0; i < manifold.getContactCount(); ++i)
+	{
+		const ContactPoint& contact = manifold.getContact(i);
+		hash = mixHash(hash ^ contact.getFeatureId());
+		hash = mixRealBits(
+			hash,
+			contact.getNormalImpulse(),
+			contact.getTangentImpulse());
+	}
+	return hash;
+}
+
+} // namespace nph
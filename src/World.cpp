@@ -3,10 +3,70 @@
 // SPDX-License-Identifier: MIT
 
 #include "neat_physics/World.h"
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include "neat_physics/WorldSnapshot.h"
+#include "BinaryIO.h"
+#include "StateHash.h"
+#include "collision/NarrowPhase.h"
+#include "collision/TimeOfImpact.h"
+#include "kernels/Kernels.h"
 
 namespace nph
 {
 
+namespace
+{
+
+/// Returns the offset aligned to the snapshot section alignment
+[[nodiscard]] uint64_t alignSectionOffset(uint64_t offset) noexcept
+{
+	constexpr uint64_t ALIGNMENT = WorldSnapshotHeader::SECTION_ALIGNMENT;
+	return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/// Writes zero bytes to a stream until it reaches the given offset
+void writePadding(std::ostream& stream, uint64_t offset, uint64_t targetOffset)
+{
+	assert(offset <= targetOffset);
+	static constexpr std::array<char, WorldSnapshotHeader::SECTION_ALIGNMENT>
+		ZEROS{};
+	stream.write(ZEROS.data(), static_cast<std::streamsize>(targetOffset - offset));
+}
+
+/// Size of the chunks a snapshot is read with from a non-seekable stream
+constexpr uint64_t SNAPSHOT_READ_CHUNK_SIZE = uint64_t{ 1 } << 20;
+
+/// Returns the number of bytes from the current position to the end
+/// of a stream or std::nullopt if the stream is not seekable
+[[nodiscard]] std::optional<uint64_t> getRemainingSize(std::istream& stream)
+{
+	const std::istream::pos_type position = stream.tellg();
+	if (position == std::istream::pos_type(-1) ||
+		!stream.seekg(0, std::ios::end))
+	{
+		stream.clear();
+		return std::nullopt;
+	}
+
+	const std::istream::pos_type end = stream.tellg();
+	stream.seekg(position);
+	if (end == std::istream::pos_type(-1) || !stream || end < position)
+	{
+		stream.clear();
+		stream.seekg(position);
+		return std::nullopt;
+	}
+	return static_cast<uint64_t>(end - position);
+}
+
+/// Separation at which a bullet is stopped before an impact;
+/// the impact is then resolved with a speculative contact
+constexpr Real CONTINUOUS_TARGET_SEPARATION = 0.005f;
+
+} // anonymous namespace
+
 World::World(
 	const Vec2& gravity,
 	uint32_t velocityIterations,
@@ -18,6 +78,7 @@ World::World(
 {
 	setVelocityIterations(velocityIterations);
 	setPositionIterations(positionIterations);
+	setKernelIsa(getBestKernelIsa());
 }
 
 void World::reserveBodies(uint32_t maxBodies)
@@ -35,10 +96,10 @@ void World::reserveBodies(uint32_t maxBodies)
 
 Body* World::addBody(
 	const Vec2& size,
-	float mass,
-	float friction,
+	Real mass,
+	Real friction,
 	const Vec2& position,
-	float rotationRad)
+	Real rotationRad)
 {
 	// We limit the number of bodies to uint32_t max value
 	if (mBodies.size() == std::numeric_limits<uint32_t>::max())
@@ -51,6 +112,17 @@ Body* World::addBody(
 	result->position = position;
 	result->rotation.setAngle(rotationRad);
 
+	// A new body does not change the other bodies and the contacts,
+	// so its hash is just added
+	const uint64_t bodyHash = hashBodyState(
+		static_cast<uint32_t>(mBodies.size() - 1),
+		*result);
+	mStateHash += bodyHash;
+	if (result->isStatic())
+	{
+		mStaticBodiesHash += bodyHash;
+	}
+
 	if (const std::ptrdiff_t memoryOffsetInBytes =
 		reinterpret_cast<std::byte*>(mBodies.data()) -
 		reinterpret_cast<const std::byte*>(oldData);
@@ -61,44 +133,590 @@ Body* World::addBody(
 	return result;
 }
 
+void World::setBodyTransform(
+	uint32_t bodyIndex,
+	const Vec2& position,
+	Real rotationRad)
+{
+	assert(bodyIndex < mBodies.size());
+	Body& body = mBodies[bodyIndex];
+	const uint64_t oldHash = hashBodyState(bodyIndex, body);
+	body.position = position;
+	body.rotation.setAngle(rotationRad);
+
+	// A moved body is not interpolated
+	if (bodyIndex < mPreviousTransforms.size())
+	{
+		mPreviousTransforms[bodyIndex] = { position, rotationRad };
+	}
+
+	const uint64_t newHash = hashBodyState(bodyIndex, body);
+	mStateHash += newHash - oldHash;
+	if (body.isStatic())
+	{
+		mStaticBodiesHash += newHash - oldHash;
+	}
+}
+
+bool World::setKernelIsa(KernelIsa isa) noexcept
+{
+	if (!isKernelIsaSupported(isa))
+	{
+		return false;
+	}
+	mCollision.setKernelIsa(isa);
+	mStats.kernelIsa = isa;
+	return true;
+}
+
 void World::clear() noexcept
 {
 	mBodies.clear();
+	mBulletStarts.clear();
+	mPreviousTransforms.clear();
+	mAccumulatedTime = 0.0f;
+	mCollision.getBroadPhase().clear();
 	mContactSolver.clear();
+	mRollback.clear();
+	mStaticBodiesHash = 0;
+	mStateHash = 0;
+}
+
+uint32_t World::advance(Real realTime)
+{
+	assert(realTime >= 0.0f);
+	mAccumulatedTime += realTime;
+
+	uint32_t stepCount = 0;
+	while (mAccumulatedTime >= mFixedTimeStep)
+	{
+		if (stepCount == mMaxStepsPerAdvance)
+		{
+			mAccumulatedTime = 0.0f;
+			break;
+		}
+
+		mPreviousTransforms.resize(mBodies.size());
+		for (uint32_t i = 0; i < mBodies.size(); ++i)
+		{
+			mPreviousTransforms[i] = {
+				mBodies[i].position,
+				mBodies[i].rotation.getAngle() };
+		}
+
+		doStep(mFixedTimeStep);
+		mAccumulatedTime -= mFixedTimeStep;
+		++stepCount;
+	}
+	return stepCount;
 }
 
-void World::doStep(float timeStep)
+BodyTransform World::getInterpolatedTransform(
+	uint32_t bodyIndex,
+	Real alpha) const noexcept
+{
+	assert(bodyIndex < mBodies.size());
+	const Body& body = mBodies[bodyIndex];
+	if (bodyIndex >= mPreviousTransforms.size())
+	{
+		return { body.position, body.rotation.getAngle() };
+	}
+
+	const BodyTransform& previous = mPreviousTransforms[bodyIndex];
+	return {
+		previous.position + alpha * (body.position - previous.position),
+		previous.angle + alpha * (body.rotation.getAngle() - previous.angle) };
+}
+
+void World::setAdaptiveStepSettings(const AdaptiveStepSettings& settings) noexcept
+{
+	assert(settings.maxSubsteps > 0);
+	assert(settings.maxMotionRatio > 0.0f);
+	assert(settings.maxPenetration > 0.0f);
+	assert(settings.maxVelocityError > 0.0f);
+	mAdaptiveStepSettings = settings;
+}
+
+void World::doStep(Real timeStep)
+{
+	if (!mAdaptiveStepSettings.enabled)
+	{
+		mStats.substepCount = 1;
+		doSingleStep(timeStep);
+		return;
+	}
+
+	const uint32_t substepCount = getAdaptiveSubstepCount(timeStep);
+	const Real substep = timeStep / Real(substepCount);
+	for (uint32_t i = 0; i < substepCount; ++i)
+	{
+		doSingleStep(substep);
+	}
+
+	mStats.substepCount = substepCount;
+	mStats.maxPenetration = mContactSolver.getMaxPenetration();
+	mStats.maxVelocityError = mContactSolver.getMaxVelocityError();
+}
+
+uint32_t World::getAdaptiveSubstepCount(Real timeStep) const noexcept
+{
+	const AdaptiveStepSettings& settings = mAdaptiveStepSettings;
+
+	// Substeps keeping the motion of each body small relative to its size
+	Real required = 1.0f;
+	for (const Body& body : mBodies)
+	{
+		if (body.isStatic())
+		{
+			continue;
+		}
+
+		const Real motion = timeStep * (
+			body.linearVelocity.length() +
+			abs(body.angularVelocity) * body.halfSize.length());
+		const Real maxMotion = settings.maxMotionRatio *
+			std::min(body.halfSize.x, body.halfSize.y);
+		required = std::max(required, motion / maxMotion);
+	}
+
+	// The penetration and the velocity error decrease
+	// about linearly with the substep
+	const Real previousCount(mStats.substepCount);
+	required = std::max({
+		required,
+		previousCount * mStats.maxPenetration / settings.maxPenetration,
+		previousCount * mStats.maxVelocityError / settings.maxVelocityError });
+
+	uint32_t result = 1;
+	while (result < settings.maxSubsteps && Real(result) < required)
+	{
+		++result;
+	}
+
+	// Decrease gradually, since a single calm step may be followed
+	// by the same violent motion
+	if (result + 1 < mStats.substepCount)
+	{
+		result = std::min(mStats.substepCount - 1, settings.maxSubsteps);
+	}
+	return result;
+}
+
+void World::doSingleStep(Real timeStep)
+{
+	prepareStep(timeStep, mVelocitySolver);
+	if (mShockPropagationIterations == 0)
+	{
+		solveVelocities(mVelocityIterations);
+	}
+	else
+	{
+		// The final velocity iterations propagate the shocks. At least half
+		// of the iterations stay regular: the fixed bodies do not yield,
+		// so a body squeezed between them or between a fixed body and a static
+		// one gains energy unless the regular iterations relax the pile
+		mContactSolver.prepareShockPropagation(mGravity);
+		const uint32_t shockIterations =
+			std::min(mShockPropagationIterations, mVelocityIterations / 2);
+		solveVelocities(mVelocityIterations - shockIterations);
+		mContactSolver.solveVelocitiesWithShock(shockIterations);
+	}
+	integratePositions(timeStep);
+	// Solving of positions is intetionally done after the integration step
+	solvePositions(mPositionIterations);
+	solveContinuousCollisions(timeStep);
+	finishStep();
+}
+
+void World::prepareStep(Real timeStep, VelocitySolver velocitySolver)
 {
 	assert(timeStep > 0.0f);
 	applyForces(timeStep);
 
+	// The speculative contacts use the velocities after applying the forces
 	mContactSolver.prepareManifoldsUpdate();
-	mCollision.update(mContactSolver);
+	mCollision.update(
+		mContactSolver,
+		mSpeculativeContactsEnabled ? timeStep : Real(0),
+		timeStep);
 	mContactSolver.finishManifoldsUpdate();
 
-	mContactSolver.prepareToSolve();
-	mContactSolver.solveVelocities(mVelocityIterations);
-	integratePositions(timeStep);
-	// Solving of positions is intetionally done after the integration step
-	mContactSolver.solvePositions(mPositionIterations);
+	mContactSolver.prepareToSolve(
+		mSpeculativeContactsEnabled ? 1.0f / timeStep : Real(0),
+		velocitySolver,
+		mJacobiRelaxation,
+		mContactReuseSettings);
+	mStats.contactCount = mContactSolver.getContactCount();
+	mStats.reusedContactCount = mContactSolver.getReusedContactCount();
 }
 
-void World::applyForces(float timeStep)
+void World::solveVelocities(uint32_t velocityIterations) noexcept
 {
-	for (auto& body : mBodies)
+	switch (mVelocitySolver)
+	{
+	case VelocitySolver::GAUSS_SEIDEL:
+		if (mDirectSolveMaxConstraints == 0)
+		{
+			mContactSolver.solveVelocities(velocityIterations);
+		}
+		else
+		{
+			mContactSolver.solveVelocitiesWithDirectSolve(
+				velocityIterations,
+				mDirectSolveMaxConstraints);
+		}
+		break;
+	case VelocitySolver::JACOBI:
+		mContactSolver.solveVelocitiesWithCopies(velocityIterations);
+		break;
+	}
+}
+
+void World::solvePositions(uint32_t positionIterations)
+{
+	switch (mPositionSolver)
 	{
-		body.linearVelocity += (!body.isStatic()) * timeStep * mGravity;
+	case PositionSolver::PBD:
+		mContactSolver.solvePositions(positionIterations);
+		break;
+	case PositionSolver::PSEUDO_VELOCITIES:
+		mContactSolver.solvePositionsWithPseudoVelocities(positionIterations);
+		break;
 	}
 }
 
-void World::integratePositions(float timeStep)
+void World::finishStep()
+{
+	updateStateHash();
+	mRollback.save(mBodies, mCollision.getBroadPhase(), mContactSolver);
+}
+
+void World::setRollbackCapacity(
+	uint32_t capacity,
+	uint32_t keyframeInterval)
+{
+	mRollback = RollbackBuffer(capacity, keyframeInterval);
+	mRollback.save(mBodies, mCollision.getBroadPhase(), mContactSolver);
+}
+
+bool World::rewind(uint32_t stepsBack)
+{
+	const bool result = mRollback.restore(
+		stepsBack,
+		mBodies,
+		mCollision.getBroadPhase(),
+		mContactSolver);
+
+	// The restored bodies are not interpolated
+	mPreviousTransforms.clear();
+	recomputeStateHash();
+	return result;
+}
+
+void World::setContactHashEnabled(bool enabled)
+{
+	mContactHashEnabled = enabled;
+	updateStateHash();
+}
+
+void World::applyForces(Real timeStep)
+{
+	getKernelTable(mStats.kernelIsa).applyForces(
+		mBodies.data(),
+		static_cast<uint32_t>(mBodies.size()),
+		timeStep,
+		mGravity);
+}
+
+void World::integratePositions(Real timeStep)
 {
+	mBulletStarts.clear();
+	for (uint32_t i = 0; i < mBodies.size(); ++i)
+	{
+		const Body& body = mBodies[i];
+		if (body.isBullet && !body.isStatic())
+		{
+			mBulletStarts.push_back({ i, body.position, body.rotation.getAngle() });
+		}
+	}
+
+	getKernelTable(mStats.kernelIsa).integratePositions(
+		mBodies.data(),
+		static_cast<uint32_t>(mBodies.size()),
+		timeStep);
+
 	for (auto& body : mBodies)
 	{
-		body.position += timeStep * body.linearVelocity;
 		body.rotation.setAngle(
 			body.rotation.getAngle() + timeStep * body.angularVelocity);
 	}
 }
 
+void World::solveContinuousCollisions(Real timeStep)
+{
+	mStats.continuousSubstepCount = 0;
+	for (const BulletStart& start : mBulletStarts)
+	{
+		Body& bullet = mBodies[start.bodyIndex];
+		Vec2 startPosition = start.position;
+		Real startAngle = start.angle;
+		Real remainingTime = timeStep;
+		for (uint32_t substep = 0; substep < MAX_CONTINUOUS_SUBSTEPS; ++substep)
+		{
+			const BoxSweep bulletSweep{
+				bullet.halfSize,
+				startPosition,
+				bullet.position,
+				startAngle,
+				bullet.rotation.getAngle() };
+			const Aabb sweepAabb = bulletSweep.getAabb();
+
+			// The first impact with the candidates of the broad phase
+			Real minFraction = 1.0f;
+			uint32_t hitIndex = 0;
+			for (const auto& [bodyIndA, bodyIndB] : mCollision.getContinuousPairs())
+			{
+				if (bodyIndA != start.bodyIndex && bodyIndB != start.bodyIndex)
+				{
+					continue;
+				}
+
+				const uint32_t i = (bodyIndA == start.bodyIndex) ? bodyIndB : bodyIndA;
+				const Body& body = mBodies[i];
+				const BoxSweep bodySweep{
+					body.halfSize,
+					body.position,
+					body.position,
+					body.rotation.getAngle(),
+					body.rotation.getAngle() };
+				if (!sweepAabb.overlaps(bodySweep.getAabb()))
+				{
+					continue;
+				}
+
+				const Real fraction = getBoxBoxTimeOfImpact(
+					bulletSweep,
+					bodySweep,
+					CONTINUOUS_TARGET_SEPARATION);
+				if (fraction < minFraction)
+				{
+					minFraction = fraction;
+					hitIndex = i;
+				}
+			}
+
+			if (minFraction >= 1.0f)
+			{
+				break;
+			}
+
+			// Move the bullet to the impact
+			bullet.position = bulletSweep.getPosition(minFraction);
+			bullet.rotation.setAngle(bulletSweep.getAngle(minFraction));
+			const Real remainingFraction = 1.0f - minFraction;
+			remainingTime *= remainingFraction;
+
+			// Solve the impact with a speculative contact
+			// covering the rest of the motion
+			const uint32_t bodyIndA = std::min(start.bodyIndex, hitIndex);
+			const uint32_t bodyIndB = std::max(start.bodyIndex, hitIndex);
+			Body& bodyA = mBodies[bodyIndA];
+			Body& bodyB = mBodies[bodyIndB];
+			CollisionManifold collision(bodyIndA, bodyIndB);
+			collision.pointsCount = getBoxBoxCollision(
+				{ bodyA.position, bodyB.position },
+				{ bodyA.rotation, bodyB.rotation },
+				{ bodyA.halfSize, bodyB.halfSize },
+				collision.points,
+				2.0f * CONTINUOUS_TARGET_SEPARATION +
+				remainingFraction * bulletSweep.getMaxDisplacement());
+			if (collision.pointsCount == 0 || remainingTime <= 0.0f)
+			{
+				break;
+			}
+
+			ContactManifold contact(bodyA, bodyB, collision);
+			contact.prepareToSolve(1.0f / remainingTime);
+			for (uint32_t i = 0; i < mVelocityIterations; ++i)
+			{
+				contact.solveVelocities();
+			}
+
+			// Integrate the bullet over the rest of the step
+			startPosition = bullet.position;
+			startAngle = bullet.rotation.getAngle();
+			bullet.position += remainingTime * bullet.linearVelocity;
+			bullet.rotation.setAngle(startAngle + remainingTime * bullet.angularVelocity);
+			++mStats.continuousSubstepCount;
+		}
+	}
+}
+
+void World::updateStateHash() noexcept
+{
+	uint64_t hash = mStaticBodiesHash;
+	for (uint32_t i = 0; i < mBodies.size(); ++i)
+	{
+		if (!mBodies[i].isStatic())
+		{
+			hash += hashBodyState(i, mBodies[i]);
+		}
+	}
+
+	// The manifold order is not deterministic across platforms,
+	// the hash addition makes it irrelevant
+	if (mContactHashEnabled)
+	{
+		for (const auto& [pairIterator, manifold] : mContactSolver.getManifolds())
+		{
+			hash += hashContactManifold(pairIterator->first, manifold);
+		}
+	}
+	mStateHash = hash;
+}
+
+void World::recomputeStateHash() noexcept
+{
+	mStaticBodiesHash = 0;
+	for (uint32_t i = 0; i < mBodies.size(); ++i)
+	{
+		if (mBodies[i].isStatic())
+		{
+			mStaticBodiesHash += hashBodyState(i, mBodies[i]);
+		}
+	}
+	updateStateHash();
+}
+
+bool World::saveSnapshot(std::ostream& stream) const
+{
+	const BroadPhase::EndpointArray endpoints =
+		mCollision.getBroadPhase().getSortedEndpoints();
+
+	ContactSolver::ManifoldRecordArray manifolds;
+	mContactSolver.getManifoldRecords(manifolds);
+
+	const uint64_t bodiesOffset = alignSectionOffset(sizeof(WorldSnapshotHeader));
+	const uint64_t bodiesEnd = bodiesOffset + mBodies.size() * sizeof(Body);
+
+	const uint64_t endpointsOffset = alignSectionOffset(bodiesEnd);
+	const uint64_t endpointsEnd =
+		endpointsOffset + endpoints.size() * sizeof(BroadPhase::Endpoint);
+
+	const uint64_t manifoldsOffset = alignSectionOffset(endpointsEnd);
+	const uint64_t manifoldsEnd =
+		manifoldsOffset + manifolds.size() * sizeof(ContactSolver::ManifoldRecord);
+
+	const WorldSnapshotHeader header{
+		WorldSnapshotHeader::MAGIC,
+		WorldSnapshotHeader::VERSION,
+		sizeof(Body),
+		sizeof(BroadPhase::Endpoint),
+		sizeof(ContactSolver::ManifoldRecord),
+		NPH_SCALAR,
+		mGravity,
+		mVelocityIterations,
+		mPositionIterations,
+		static_cast<uint32_t>(mBodies.size()),
+		static_cast<uint32_t>(endpoints.size()),
+		static_cast<uint32_t>(manifolds.size()),
+		bodiesOffset,
+		endpointsOffset,
+		manifoldsOffset,
+		manifoldsEnd };
+
+	writeValue(stream, header);
+
+	writePadding(stream, sizeof(header), bodiesOffset);
+	writeArray(stream, mBodies.data(), mBodies.size());
+
+	writePadding(stream, bodiesEnd, endpointsOffset);
+	writeArray(stream, endpoints.data(), endpoints.size());
+
+	writePadding(stream, endpointsEnd, manifoldsOffset);
+	writeArray(stream, manifolds.data(), manifolds.size());
+	return static_cast<bool>(stream);
+}
+
+bool World::loadSnapshot(std::istream& stream)
+{
+	WorldSnapshotHeader header;
+	if (!readValue(stream, header) ||
+		header.magic != WorldSnapshotHeader::MAGIC ||
+		header.version != WorldSnapshotHeader::VERSION ||
+		header.totalSize < sizeof(header))
+	{
+		clear();
+		return false;
+	}
+
+	// The snapshot size comes from the stream, so the buffer is not allocated
+	// before the stream is known to hold the data: a seekable stream
+	// is checked for the remaining size and read with a single bulk read,
+	// a non-seekable one is read in bounded chunks.
+	// The buffer is 8-byte aligned, so the sections stay aligned.
+	const uint64_t dataSize = header.totalSize - sizeof(header);
+	const std::optional<uint64_t> remainingSize = getRemainingSize(stream);
+	if (remainingSize && *remainingSize < dataSize)
+	{
+		clear();
+		return false;
+	}
+
+	std::vector<uint64_t> data;
+	uint64_t readSize = 0;
+	while (readSize < dataSize)
+	{
+		const uint64_t chunkSize = remainingSize ?
+			dataSize :
+			std::min(dataSize - readSize, SNAPSHOT_READ_CHUNK_SIZE);
+
+		data.resize(
+			(sizeof(header) + readSize + chunkSize + sizeof(uint64_t) - 1) /
+			sizeof(uint64_t));
+
+		std::byte* const bytes = reinterpret_cast<std::byte*>(data.data());
+		if (!readArray(stream, bytes + sizeof(header) + readSize, chunkSize))
+		{
+			clear();
+			return false;
+		}
+		readSize += chunkSize;
+	}
+
+	data.resize((header.totalSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+	std::byte* const bytes = reinterpret_cast<std::byte*>(data.data());
+	std::memcpy(bytes, &header, sizeof(header));
+	return loadSnapshot(WorldSnapshotView(bytes, header.totalSize));
+}
+
+bool World::loadSnapshot(const WorldSnapshotView& snapshot)
+{
+	clear();
+	if (!snapshot.isValid())
+	{
+		return false;
+	}
+
+	// Bodies are copy-constructed at once,
+	// since Body is trivially copyable but not assignable
+	const std::span<const Body> bodies = snapshot.getBodies();
+	mBodies = BodyArray(bodies.begin(), bodies.end());
+
+	if (!mCollision.getBroadPhase().setEndpoints(snapshot.getEndpoints()) ||
+		!mContactSolver.setManifolds(snapshot.getManifolds()))
+	{
+		clear();
+		return false;
+	}
+
+	const WorldSnapshotHeader& header = snapshot.getHeader();
+	mGravity = header.gravity;
+	mVelocityIterations = header.velocityIterations;
+	mPositionIterations = header.positionIterations;
+	recomputeStateHash();
+	mRollback.save(mBodies, mCollision.getBroadPhase(), mContactSolver);
+	return true;
+}
+
 } // namespace nph
@@ -0,0 +1,107 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "neat_physics/WorldSnapshot.h"
+
+namespace nph
+{
+
+namespace
+{
+
+/// Checks that a section is aligned and lies within the snapshot
+[[nodiscard]] bool isSectionValid(
+	uint64_t offset,
+	uint64_t count,
+	uint64_t elementSize,
+	uint64_t totalSize) noexcept
+{
+	return
+		offset % WorldSnapshotHeader::SECTION_ALIGNMENT == 0 &&
+		offset >= sizeof(WorldSnapshotHeader) &&
+		offset <= totalSize &&
+		count <= (totalSize - offset) / elementSize;
+}
+
+/// Returns a typed pointer to a snapshot section
+template <typename T>
+[[nodiscard]] const T* getSection(
+	const WorldSnapshotHeader* header,
+	uint64_t offset) noexcept
+{
+	return reinterpret_cast<const T*>(
+		reinterpret_cast<const std::byte*>(header) + offset);
+}
+
+} // anonymous namespace
+
+WorldSnapshotView::WorldSnapshotView(const void* data, size_t size) noexcept
+{
+	if (data == nullptr ||
+		reinterpret_cast<uintptr_t>(data) % alignof(WorldSnapshotHeader) != 0 ||
+		size < sizeof(WorldSnapshotHeader))
+	{
+		return;
+	}
+
+	const auto* header = static_cast<const WorldSnapshotHeader*>(data);
+	if (header->magic != WorldSnapshotHeader::MAGIC ||
+		header->version != WorldSnapshotHeader::VERSION ||
+		header->bodySize != sizeof(Body) ||
+		header->endpointSize != sizeof(BroadPhase::Endpoint) ||
+		header->manifoldSize != sizeof(ContactSolver::ManifoldRecord) ||
+		header->scalarType != NPH_SCALAR ||
+		header->velocityIterations == 0 ||
+		header->totalSize > size ||
+		!isSectionValid(
+			header->bodiesOffset,
+			header->bodyCount,
+			sizeof(Body),
+			header->totalSize) ||
+		!isSectionValid(
+			header->endpointsOffset,
+			header->endpointCount,
+			sizeof(BroadPhase::Endpoint),
+			header->totalSize) ||
+		!isSectionValid(
+			header->manifoldsOffset,
+			header->manifoldCount,
+			sizeof(ContactSolver::ManifoldRecord),
+			header->totalSize))
+	{
+		return;
+	}
+	mHeader = header;
+}
+
+std::span<const Body> WorldSnapshotView::getBodies() const noexcept
+{
+	assert(isValid());
+	return {
+		getSection<Body>(mHeader, mHeader->bodiesOffset),
+		mHeader->bodyCount };
+}
+
+std::span<const BroadPhase::Endpoint>
+	WorldSnapshotView::getEndpoints() const noexcept
+{
+	assert(isValid());
+	return {
+		getSection<BroadPhase::Endpoint>(mHeader, mHeader->endpointsOffset),
+		mHeader->endpointCount };
+}
+
+std::span<const ContactSolver::ManifoldRecord>
+	WorldSnapshotView::getManifolds() const noexcept
+{
+	assert(isValid());
+	return {
+		getSection<ContactSolver::ManifoldRecord>(
+			mHeader,
+			mHeader->manifoldsOffset),
+		mHeader->manifoldCount };
+}
+
+} // namespace nph
@@ -6,6 +6,7 @@
 #include "neat_physics/collision/BroadPhase.h"
 #include <algorithm>
 #include <iterator>
+#include "../kernels/Kernels.h"
 
 namespace nph
 {
@@ -27,51 +28,154 @@ Aabb getAabb(const Body& body) noexcept
 	};
 }
 
-} // anonymous namespace
+/// Computes the AABB for a box-shaped body moving with its current velocity
+/// during a time interval
+Aabb getSweptAabb(const Body& body, Real time) noexcept
+{
+	const Mat22 absRotation = abs(body.rotation.getMat());
+	Vec2 halfExtents =
+		body.halfSize.x * absRotation.col1 +
+		body.halfSize.y * absRotation.col2;
 
-void BroadPhase::update(BroadPhaseCallback& callback)
+	// A rotation by an angle moves the vertices by at most
+	// angle * radius and never beyond the radius
+	const Real radius = body.halfSize.length();
+	const Real rotationOffset = abs(body.angularVelocity) * time * radius;
+	halfExtents.x = std::min(halfExtents.x + rotationOffset, radius);
+	halfExtents.y = std::min(halfExtents.y + rotationOffset, radius);
+
+	const Vec2 translation = time * body.linearVelocity;
+	return {
+		body.position - halfExtents + Vec2(
+			std::min(translation.x, Real(0)),
+			std::min(translation.y, Real(0))),
+		body.position + halfExtents + Vec2(
+			std::max(translation.x, Real(0)),
+			std::max(translation.y, Real(0)))
+	};
+}
+
+/// Computes the AABB for a bullet body moving in any direction during
+/// a time interval with the speeds not above the current ones, so it
+/// contains the sweep of the bullet after its velocity is changed by the solver
+Aabb getContinuousAabb(const Body& body, Real time) noexcept
+{
+	const Real radius = body.halfSize.length();
+	const Aabb aabb = getAabb(body);
+	const Real rotationOffset = std::min(
+		abs(body.angularVelocity) * time * radius,
+		radius);
+	const Real offset = time * body.linearVelocity.length() + rotationOffset;
+	return {
+		aabb.min - Vec2(offset, offset),
+		aabb.max + Vec2(offset, offset)
+	};
+}
+
+/// Computes the AABBs of the bodies, swept over the speculative time if it is > 0;
+/// the AABBs of the dynamic bullets are swept over the continuous time if it is > 0
+void computeAabbs(
+	const BodyArray& bodies,
+	Real speculativeTime,
+	Real continuousTime,
+	BroadPhase::AabbArray& aabbs)
 {
 	// Reserve-emplace because Aabb is immutable
-	mAabbs.clear();
-	mAabbs.reserve(mBodies.size());
-	for (size_t i = 0; i < mBodies.size(); ++i)
+	aabbs.clear();
+	aabbs.reserve(bodies.size());
+	for (const Body& body : bodies)
 	{
-		mAabbs.emplace_back(getAabb(mBodies[i]));
+		if (continuousTime > 0.0f && body.isBullet && !body.isStatic())
+		{
+			aabbs.emplace_back(getContinuousAabb(
+				body,
+				std::max(continuousTime, speculativeTime)));
+		}
+		else
+		{
+			aabbs.emplace_back(speculativeTime > 0.0f ?
+				getSweptAabb(body, speculativeTime) :
+				getAabb(body));
+		}
 	}
+}
+
+} // anonymous namespace
 
+void BroadPhase::update(
+	BroadPhaseCallback& callback,
+	Real speculativeTime,
+	Real continuousTime)
+{
+	assert(speculativeTime >= 0.0f);
+	assert(continuousTime >= 0.0f);
+	mSpeculativeTime = speculativeTime;
+	mContinuousTime = continuousTime;
+	computeAabbs(mBodies, mSpeculativeTime, mContinuousTime, mAabbs);
 	mActiveMapping.resize(mBodies.size());
+	updateEndpoints(mAabbs, mEndpoints);
+	sweepAxis(callback);
+}
+
+void BroadPhase::updateEndpoints(
+	const AabbArray& aabbs,
+	EndpointArray& endpoints)
+{
 	// Very inefficient, but it is really actual since
 	// currently there is no body removal,only clearing all
-	if (mEndpoints.size() > mBodies.size() * 2)
+	if (endpoints.size() > aabbs.size() * 2)
 	{
-		mEndpoints.clear();
+		endpoints.clear();
 	}
 
 	// Add endpoints for bodies that have been added since the last update
-	assert(mEndpoints.size() % 2 == 0);
-	for (int32_t ei = static_cast<int32_t>(mEndpoints.size() >> 1);
-		ei < static_cast<int32_t>(mBodies.size()); ++ei) // Endpoint index
+	assert(endpoints.size() % 2 == 0);
+	const bool endpointsAdded = endpoints.size() < aabbs.size() * 2;
+	for (int32_t ei = static_cast<int32_t>(endpoints.size() >> 1);
+		ei < static_cast<int32_t>(aabbs.size()); ++ei) // Endpoint index
 	{
-		mEndpoints.emplace_back(0.0f, ei, true);
-		mEndpoints.emplace_back(0.0f, ei, false);
+		endpoints.emplace_back(0.0f, ei, true);
+		endpoints.emplace_back(0.0f, ei, false);
 	}
 
 	// Update endpoint positions
-	for (auto& endpoint : mEndpoints)
+	for (auto& endpoint : endpoints)
 	{
 		endpoint.position = endpoint.isStart ?
-			mAabbs[ endpoint.index ].min.x :
-			mAabbs[ endpoint.index ].max.x;
+			aabbs[ endpoint.index ].min.x :
+			aabbs[ endpoint.index ].max.x;
 	}
 
-	// \todo Explicitly use the insertion sort
-	std::sort(mEndpoints.begin(), mEndpoints.end());
-	sweepAxis(callback);
+	if (endpointsAdded)
+	{
+		std::stable_sort(endpoints.begin(), endpoints.end());
+	}
+	else
+	{
+		// Due to temporal coherence the endpoints are almost sorted,
+		// so the insertion sort runs in nearly linear time
+		for (size_t i = 1; i < endpoints.size(); ++i)
+		{
+			const Endpoint endpoint = endpoints[i];
+			size_t j = i;
+			for (; j > 0 && endpoint < endpoints[j - 1]; --j)
+			{
+				endpoints[j] = endpoints[j - 1];
+			}
+			endpoints[j] = endpoint;
+		}
+	}
 }
 
 void BroadPhase::sweepAxis(BroadPhaseCallback& callback)
 {
+	const KernelTable& kernels = getKernelTable(mKernelIsa);
 	mActivePoints.clear();
+	mActiveMinY.clear();
+	mActiveMaxY.clear();
+	mActiveStatic.clear();
+	mOverlapSlots.resize(mBodies.size());
+
 	for (const auto& endpoint : mEndpoints)
 	{
 		if (endpoint.isStart)
@@ -80,21 +184,23 @@ void BroadPhase::sweepAxis(BroadPhaseCallback& callback)
 			const Body& bodyA = mBodies[i1];
 			const Aabb& aabbA = mAabbs[i1];
 
-			for (uint32_t i2 : mActivePoints)
-			{
-				if (bodyA.isStatic() && mBodies[i2].isStatic())
+			// The active AABBs which y-axes intersect the current one,
+			// except the static ones for a static body
+			const uint32_t overlapCount = kernels.findActiveOverlaps(
 				{
-					continue;
-				}
-
-				// If y-axes don't intersect
-				const Aabb& aabbB = mAabbs[i2];
-				if (aabbA.max.y < aabbB.min.y ||
-					aabbB.max.y < aabbA.min.y)
-				{
-					continue;
-				}
+					mActiveMinY.data(),
+					mActiveMaxY.data(),
+					mActiveStatic.data(),
+					static_cast<uint32_t>(mActivePoints.size())
+				},
+				aabbA.min.y,
+				aabbA.max.y,
+				bodyA.isStatic(),
+				mOverlapSlots.data());
 
+			for (uint32_t s = 0; s < overlapCount; ++s)
+			{
+				const uint32_t i2 = mActivePoints[mOverlapSlots[s]];
 				if (i1 < i2)
 				{
 					callback.onCollision(i1, i2);
@@ -106,6 +212,9 @@ void BroadPhase::sweepAxis(BroadPhaseCallback& callback)
 			}
 			mActiveMapping[endpoint.index] = static_cast<uint32_t>(mActivePoints.size());
 			mActivePoints.push_back(i1);
+			mActiveMinY.push_back(aabbA.min.y);
+			mActiveMaxY.push_back(aabbA.max.y);
+			mActiveStatic.push_back(bodyA.isStatic() ? 1.0f : 0.0f);
 		}
 		else
 		{
@@ -115,8 +224,68 @@ void BroadPhase::sweepAxis(BroadPhaseCallback& callback)
 			mActivePoints[idx] = last;
 			mActiveMapping[last] = idx;
 			mActivePoints.pop_back();
+
+			mActiveMinY[idx] = mActiveMinY.back();
+			mActiveMinY.pop_back();
+			mActiveMaxY[idx] = mActiveMaxY.back();
+			mActiveMaxY.pop_back();
+			mActiveStatic[idx] = mActiveStatic.back();
+			mActiveStatic.pop_back();
 		}
 	}
 }
 
+void BroadPhase::clear() noexcept
+{
+	mAabbs.clear();
+	mEndpoints.clear();
+	mActivePoints.clear();
+	mActiveMinY.clear();
+	mActiveMaxY.clear();
+	mActiveStatic.clear();
+	mActiveMapping.clear();
+}
+
+BroadPhase::EndpointArray BroadPhase::getSortedEndpoints() const
+{
+	AabbArray aabbs;
+	computeAabbs(mBodies, mSpeculativeTime, mContinuousTime, aabbs);
+	EndpointArray result(mEndpoints);
+	updateEndpoints(aabbs, result);
+	return result;
+}
+
+bool BroadPhase::setEndpoints(std::span<const Endpoint> endpoints)
+{
+	clear();
+	if (endpoints.size() > mBodies.size() * 2 ||
+		endpoints.size() % 2 != 0 ||
+		std::any_of(
+			endpoints.begin(),
+			endpoints.end(),
+			[count = endpoints.size() / 2](const Endpoint& endpoint)
+			{
+				return endpoint.index >= count;
+			}))
+	{
+		return false;
+	}
+
+	// Each segment must have exactly one start and one end,
+	// otherwise the sweep would remove a segment that is not active
+	std::vector<uint8_t> segmentFlags(endpoints.size() / 2, 0);
+	for (const Endpoint& endpoint : endpoints)
+	{
+		const uint8_t flag = endpoint.isStart ? 1 : 2;
+		if (segmentFlags[endpoint.index] & flag)
+		{
+			return false;
+		}
+		segmentFlags[endpoint.index] |= flag;
+	}
+
+	mEndpoints.assign(endpoints.begin(), endpoints.end());
+	return true;
+}
+
 } // namespace nph
@@ -4,19 +4,114 @@
 
 // Includes
 #include "neat_physics/collision/CollisionSystem.h"
+#include <algorithm>
 #include "NarrowPhase.h"
+#include "../kernels/Kernels.h"
 
 namespace nph
 {
 
-void CollisionSystem::update(CollisionCallback& callback)
+namespace
 {
-	mCallback = &callback;
-	mBroadPhase.update(*this);
-	mCallback = nullptr;
+
+/// Returns the upper bound of the distance two boxes can approach
+/// during a time interval with their current velocities
+[[nodiscard]] Real getSpeculativeDistance(
+	const Body& bodyA,
+	const Body& bodyB,
+	Real time) noexcept
+{
+	if (time <= 0.0f)
+	{
+		return 0.0f;
+	}
+	return time * (
+		(bodyB.linearVelocity - bodyA.linearVelocity).length() +
+		abs(bodyA.angularVelocity) * bodyA.halfSize.length() +
+		abs(bodyB.angularVelocity) * bodyB.halfSize.length());
+}
+
+} // anonymous namespace
+
+void CollisionSystem::update(
+	CollisionCallback& callback,
+	Real speculativeTime,
+	Real continuousTime)
+{
+	mPairs.clear();
+	mContinuousPairs.clear();
+	mBroadPhase.update(*this, speculativeTime, continuousTime);
+
+	const KernelTable& kernels = getKernelTable(getKernelIsa());
+	if (kernels.findOverlappingBoxPairs == nullptr)
+	{
+		for (const auto& [bodyIndA, bodyIndB] : mPairs)
+		{
+			collide(
+				bodyIndA,
+				bodyIndB,
+				getSpeculativeDistance(
+					mBodies[bodyIndA],
+					mBodies[bodyIndB],
+					speculativeTime),
+				callback);
+		}
+		return;
+	}
+
+	// Reject the separated pairs in batches before the narrow phase;
+	// the pairs are processed in the broad phase order
+	alignas(64) static thread_local BoxPairBatch batch;
+	for (size_t start = 0; start < mPairs.size(); start += BoxPairBatch::CAPACITY)
+	{
+		const uint32_t count = static_cast<uint32_t>(std::min<size_t>(
+			mPairs.size() - start, BoxPairBatch::CAPACITY));
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const auto& [bodyIndA, bodyIndB] = mPairs[start + i];
+			batch.set(
+				i,
+				mBodies[bodyIndA],
+				mBodies[bodyIndB],
+				getSpeculativeDistance(
+					mBodies[bodyIndA],
+					mBodies[bodyIndB],
+					speculativeTime));
+		}
+
+		const uint64_t overlapping = kernels.findOverlappingBoxPairs(batch, count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if ((overlapping >> i) & 1u)
+			{
+				const auto& [bodyIndA, bodyIndB] = mPairs[start + i];
+				collide(bodyIndA, bodyIndB, batch.margins[i], callback);
+			}
+		}
+	}
 }
 
 void CollisionSystem::onCollision(uint32_t bodyIndA, uint32_t bodyIndB)
+{
+	mPairs.emplace_back(bodyIndA, bodyIndB);
+
+	// The bullets are swept against the static bodies and the other bullets;
+	// the broad phase does not report the static pairs
+	const Body& bodyA = mBodies[bodyIndA];
+	const Body& bodyB = mBodies[bodyIndB];
+	if ((bodyA.isBullet || bodyA.isStatic()) &&
+		(bodyB.isBullet || bodyB.isStatic()) &&
+		(bodyA.isBullet || bodyB.isBullet))
+	{
+		mContinuousPairs.emplace_back(bodyIndA, bodyIndB);
+	}
+}
+
+void CollisionSystem::collide(
+	uint32_t bodyIndA,
+	uint32_t bodyIndB,
+	Real speculativeDistance,
+	CollisionCallback& callback)
 {
 	const Body& bodyA = mBodies[bodyIndA];
 	const Body& bodyB = mBodies[bodyIndB];
@@ -26,11 +121,12 @@ void CollisionSystem::onCollision(uint32_t bodyIndA, uint32_t bodyIndB)
 		{ bodyA.position, bodyB.position },
 		{ bodyA.rotation, bodyB.rotation },
 		{ bodyA.halfSize, bodyB.halfSize },
-		manifold.points);
+		manifold.points,
+		speculativeDistance);
 
 	if (manifold.pointsCount > 0)
 	{
-		mCallback->onCollision(manifold);
+		callback.onCollision(manifold);
 	}
 }
 
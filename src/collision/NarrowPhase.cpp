@@ -36,7 +36,7 @@ bool clipEdgeByPlane(
 	ClippedEdge& target)
 {
 	uint32_t pointCount = 0;
-	std::array<float, 2> distances;
+	std::array<Real, 2> distances;
 	for (size_t pi = 0; pi < 2; ++pi)
 	{
 		distances[pi] = clipPlane.getDistance(source[pi].position);
@@ -51,7 +51,7 @@ bool clipEdgeByPlane(
 	{
 		ClippedPoint& point = target[pointCount++];
 
-		const float lerpFactor = distances[0] / (distances[0] - distances[1]);
+		const Real lerpFactor = distances[0] / (distances[0] - distances[1]);
 		point.position =
 			source[0].position +
 			lerpFactor * (source[1].position - source[0].position);
@@ -74,10 +74,12 @@ uint32_t getBoxBoxCollision(
 	const Vec2Array2& positions,
 	const RotationArray2 rotations,
 	const Vec2Array2& halfSizes,
-	CollisionPointArray& result)
+	CollisionPointArray& result,
+	Real speculativeDistance)
 {
 	assert(halfSizes[0].x > 0.0f && halfSizes[0].y > 0.0f);
 	assert(halfSizes[1].x > 0.0f && halfSizes[1].y > 0.0f);
+	assert(speculativeDistance >= 0.0f);
 
 	// Inverse rotation matrices
 	const Mat22Array2 invRotations{
@@ -85,9 +87,10 @@ uint32_t getBoxBoxCollision(
 		rotations[1].getInverseMat()
 	};
 
-	// Step 1: find the min penetration or a separating axis
-	uint32_t clipBoxInd;
-	uint32_t clipAxisInd; // 0 - x axis, 1 - y axis
+	// Step 1: find the min penetration or a separating axis;
+	// for separated boxes the min penetration is the max separation
+	uint32_t clipBoxInd = 0;
+	uint32_t clipAxisInd = 0; // 0 - x axis, 1 - y axis
 	Vec2 minPenetrationDir;
 	{
 		const Vec2 centersVec = positions[1] - positions[0];
@@ -99,7 +102,7 @@ uint32_t getBoxBoxCollision(
 			abs(abRelRotation.getTransposed())
 		};
 
-		float minPenetration = std::numeric_limits<float>::max();
+		Real minPenetration = std::numeric_limits<Real>::max();
 		for (uint32_t bi = 0; bi < 2; ++bi) // box index
 		{
 			const Vec2 otherBoxProjections =
@@ -109,7 +112,7 @@ uint32_t getBoxBoxCollision(
 			const Vec2 penetrations = halfSizes[bi] - otherBoxProjections;
 			for (uint32_t ai = 0; ai < 2; ++ai) // axis index
 			{
-				if (penetrations[ai] < 0.0f)
+				if (penetrations[ai] < -speculativeDistance)
 				{
 					return 0;
 				}
@@ -160,7 +163,7 @@ uint32_t getBoxBoxCollision(
 		const Vec2 incidentDir = -(invRotations[incidentBoxInd] * clipNormal);
 
 		uint32_t incidentEdge;
-		if (std::abs(incidentDir.x) > std::abs(incidentDir.y))
+		if (abs(incidentDir.x) > abs(incidentDir.y))
 		{
 			// +-X direction
 			incidentEdge = incidentDir.x > 0.0 ? 3 : 1;
@@ -234,8 +237,9 @@ uint32_t getBoxBoxCollision(
 		for (uint32_t pi = 0; pi < 2; ++pi) // point index
 		{
 			ClippedPoint& point = edge[pi];
-			const float penetration = -clipPlane.getDistance(point.position);
-			if (penetration < 0.0f)
+			// A negative penetration is the gap of a speculative point
+			const Real penetration = -clipPlane.getDistance(point.position);
+			if (penetration < -speculativeDistance)
 			{
 				continue;
 			}
@@ -274,4 +278,35 @@ uint32_t getBoxBoxCollision(
 	return resultPointCount;
 }
 
+Real getBoxBoxSeparation(
+	const Vec2Array2& positions,
+	const RotationArray2& rotations,
+	const Vec2Array2& halfSizes) noexcept
+{
+	// The same projections as in the step 1 of getBoxBoxCollision
+	const Mat22Array2 invRotations{
+		rotations[0].getInverseMat(),
+		rotations[1].getInverseMat()
+	};
+
+	const Vec2 centersVec = positions[1] - positions[0];
+	const Mat22 abRelRotation = invRotations[0] * rotations[1].getMat();
+	const Mat22Array2 absRelRotations{
+		abs(abRelRotation),
+		abs(abRelRotation.getTransposed())
+	};
+
+	Real maxSeparation = -std::numeric_limits<Real>::max();
+	for (uint32_t bi = 0; bi < 2; ++bi) // box index
+	{
+		const Vec2 separations =
+			abs(invRotations[bi] * centersVec) -
+			absRelRotations[1 - bi] * halfSizes[1 - bi] -
+			halfSizes[bi];
+
+		maxSeparation = std::max({ maxSeparation, separations.x, separations.y });
+	}
+	return maxSeparation;
+}
+
 } // namespace nph
@@ -21,12 +21,23 @@ using RotationArray2 = std::array<Rotation, 2>;
 using Mat22Array2 = std::array<Mat22, 2>;
 
 /// Computes collision points between 2 boxes
+/// \param speculativeDistance Separated boxes closer than this distance
+/// yield speculative collision points with negative penetrations; must be >= 0
 /// \return Number of collision points found (0-2)
 uint32_t getBoxBoxCollision(
 	const Vec2Array2& positions,
 	const RotationArray2 rotations,
 	const Vec2Array2& halfSizes,
-	CollisionPointArray& result);
+	CollisionPointArray& result,
+	Real speculativeDistance = 0.0f);
+
+/// Computes the separation of 2 boxes along the axes of the boxes:
+/// a lower bound of the distance between separated boxes,
+/// negative for overlapping boxes
+[[nodiscard]] Real getBoxBoxSeparation(
+	const Vec2Array2& positions,
+	const RotationArray2& rotations,
+	const Vec2Array2& halfSizes) noexcept;
 
 // End of namespace nph
 }
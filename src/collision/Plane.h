@@ -17,7 +17,7 @@ struct Plane
 	const Vec2 normal;
 
 	/// Offset from the origin
-	float offset;
+	Real offset;
 
 	/// Default constructor (no initialization)
 	Plane() noexcept = default;
@@ -25,7 +25,7 @@ struct Plane
 	/// Constructs plane from normal and offset
 	Plane(
 		const Vec2& inNormal,
-		float inOffset) noexcept :
+		Real inOffset) noexcept :
 
 		normal(inNormal),
 		offset(inOffset)
@@ -46,14 +46,14 @@ struct Plane
 	Plane(
 		const Vec2& inNormal,
 		const Vec2& inOrigin,
-		float inOffset) noexcept :
+		Real inOffset) noexcept :
 
 		Plane(inNormal, dot(inNormal, inOrigin) + inOffset)
 	{
 	}
 
 	/// Returns the signed distance from the plane to the point
-	[[nodiscard]] float getDistance(const Vec2& point) const noexcept
+	[[nodiscard]] Real getDistance(const Vec2& point) const noexcept
 	{
 		return dot(normal, point) - offset;
 	}
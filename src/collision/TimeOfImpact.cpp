@@ -0,0 +1,108 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "TimeOfImpact.h"
+#include <algorithm>
+#include "NarrowPhase.h"
+
+namespace nph
+{
+
+Aabb BoxSweep::getAabb() const noexcept
+{
+	// A box at any angle is inside the circle of its radius
+	const Real radius = halfSize.length();
+	return {
+		Vec2(
+			std::min(position0.x, position1.x) - radius,
+			std::min(position0.y, position1.y) - radius),
+		Vec2(
+			std::max(position0.x, position1.x) + radius,
+			std::max(position0.y, position1.y) + radius) };
+}
+
+Real getBoxBoxTimeOfImpact(
+	const BoxSweep& sweepA,
+	const BoxSweep& sweepB,
+	Real targetSeparation) noexcept
+{
+	assert(targetSeparation > 0.0f);
+
+	// Maximum number of advancement iterations
+	static constexpr uint32_t MAX_ITERATIONS = 20;
+
+	// Advancement stops within this fraction of the target separation
+	static constexpr Real TOLERANCE_FACTOR = 0.25f;
+
+	// Boxes about the target apart approach if their separation decreases
+	// by more than this fraction of the target while they move by the target;
+	// the threshold is far above the rounding noise of the separation
+	static constexpr Real MIN_APPROACH_FACTOR = 0.01f;
+
+	const Real maxApproach =
+		sweepA.getMaxDisplacement() +
+		sweepB.getMaxDisplacement();
+	if (maxApproach <= 0.0f)
+	{
+		return 1.0f;
+	}
+
+	const Vec2Array2 halfSizes{ sweepA.halfSize, sweepB.halfSize };
+	const auto getSeparation = [&](Real fraction)
+	{
+		return getBoxBoxSeparation(
+			{ sweepA.getPosition(fraction), sweepB.getPosition(fraction) },
+			{ Rotation(sweepA.getAngle(fraction)), Rotation(sweepB.getAngle(fraction)) },
+			halfSizes);
+	};
+
+	// Overlapping boxes are left to the discrete contacts
+	Real separation = getSeparation(0.0f);
+	if (separation <= 0.0f)
+	{
+		return 1.0f;
+	}
+
+	// Boxes already about the target apart, e.g. after an impact
+	// in the previous substep, are at the impact if they approach;
+	// advancing them further would stall in the rounding noise
+	const Real tolerance = TOLERANCE_FACTOR * targetSeparation;
+	if (separation < targetSeparation + tolerance)
+	{
+		const Real probeFraction = std::min(targetSeparation / maxApproach, Real(1));
+		return separation - getSeparation(probeFraction) >
+			MIN_APPROACH_FACTOR * targetSeparation ? 0.0f : 1.0f;
+	}
+
+	Real fraction = 0.0f;
+	for (uint32_t iteration = 0; iteration < MAX_ITERATIONS; ++iteration)
+	{
+		if (separation < targetSeparation + tolerance)
+		{
+			return fraction;
+		}
+
+		fraction += (separation - targetSeparation) / maxApproach;
+		if (fraction >= 1.0f)
+		{
+			return 1.0f;
+		}
+
+		// The boxes moving apart or in parallel, e.g. a bullet sliding
+		// along a floor, do not approach later in the interval
+		const Real nextSeparation = getSeparation(fraction);
+		if (nextSeparation >= separation)
+		{
+			return 1.0f;
+		}
+		separation = nextSeparation;
+	}
+
+	// The target is not reached, so there is no impact to substep;
+	// the discrete contacts handle the rest of the approach
+	return 1.0f;
+}
+
+} // namespace nph
@@ -0,0 +1,73 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include "neat_physics/collision/Aabb.h"
+#include "neat_physics/math/Rotation.h"
+
+namespace nph
+{
+
+/// Motion of a box during a time interval: the position and the angle
+/// change linearly from the start to the end
+struct BoxSweep
+{
+	/// Half size of the box
+	Vec2 halfSize;
+
+	/// Position at the start
+	Vec2 position0;
+
+	/// Position at the end
+	Vec2 position1;
+
+	/// Angle at the start, in radians
+	Real angle0;
+
+	/// Angle at the end, in radians
+	Real angle1;
+
+	/// Returns the position at a fraction of the interval in [0, 1]
+	[[nodiscard]] Vec2 getPosition(Real fraction) const noexcept
+	{
+		return position0 + fraction * (position1 - position0);
+	}
+
+	/// Returns the angle at a fraction of the interval in [0, 1]
+	[[nodiscard]] Real getAngle(Real fraction) const noexcept
+	{
+		return angle0 + fraction * (angle1 - angle0);
+	}
+
+	/// Returns the upper bound of the distance a point of the box moves
+	[[nodiscard]] Real getMaxDisplacement() const noexcept
+	{
+		return
+			(position1 - position0).length() +
+			abs(angle1 - angle0) * halfSize.length();
+	}
+
+	/// Returns an AABB containing the box during the whole motion
+	[[nodiscard]] Aabb getAabb() const noexcept;
+};
+
+/// Computes the time of impact of two moving boxes by conservative
+/// advancement: the boxes are advanced by the separation along the box axes
+/// (a lower bound of the distance) divided by the upper bound of the
+/// approach speed until they are about targetSeparation apart.
+/// The advancement never passes the impact, so thin and fast boxes
+/// do not tunnel. Boxes about targetSeparation apart at the start
+/// are at the impact (fraction 0) if they approach.
+/// \return the fraction of the interval in [0, 1) at the impact,
+/// or 1 if the boxes overlap at the start of the interval, do not reach
+/// the target separation during it, stop approaching (e.g. move in parallel)
+/// or do not reach the target within the maximum number of iterations
+[[nodiscard]] Real getBoxBoxTimeOfImpact(
+	const BoxSweep& sweepA,
+	const BoxSweep& sweepB,
+	Real targetSeparation) noexcept;
+
+} // namespace nph
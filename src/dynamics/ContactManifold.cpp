@@ -4,6 +4,7 @@
 
 // Includes
 #include "neat_physics/dynamics/ContactManifold.h"
+#include <algorithm>
 
 
 namespace nph
@@ -17,15 +18,49 @@ ContactManifold::ContactManifold(
 
 	mBodyA(&bodyA),
 	mBodyB(&bodyB),
-	mContacts{ manifold.points[0], manifold.points[1] },
 	mContactCount(manifold.pointsCount),
 	mObsolete(false),
 
 	// A well-known approximation for friction between two materials
 	// \todo: introduce material pairs
-	mFriction(std::sqrt(mBodyA->friction * mBodyB->friction))
+	mFriction(squareRoot(mBodyA->friction * mBodyB->friction)),
+	mIsPrepared(false)
 {
 	assert(0 < mContactCount && mContactCount <= MAX_COLLISION_POINTS);
+	for (uint32_t i = 0; i < mContactCount; ++i)
+	{
+		mContacts[i] = ContactPoint(manifold.points[i]);
+	}
+}
+
+ContactManifold::ContactManifold(
+	Body& bodyA,
+	Body& bodyB,
+	const State& state) noexcept :
+
+	mBodyA(&bodyA),
+	mBodyB(&bodyB),
+	mContactCount(state.contactCount),
+	mObsolete(false),
+	mFriction(squareRoot(mBodyA->friction * mBodyB->friction)),
+	mIsPrepared(false)
+{
+	assert(0 < mContactCount && mContactCount <= MAX_COLLISION_POINTS);
+	for (uint32_t i = 0; i < mContactCount; ++i)
+	{
+		mContacts[i] = ContactPoint(state.contacts[i]);
+	}
+}
+
+ContactManifold::State ContactManifold::getState() const noexcept
+{
+	State result{};
+	for (uint32_t i = 0; i < mContactCount; ++i)
+	{
+		result.contacts[i] = mContacts[i].getState();
+	}
+	result.contactCount = mContactCount;
+	return result;
 }
 
 void ContactManifold::update(const CollisionManifold& newManifold) noexcept
@@ -45,8 +80,7 @@ void ContactManifold::update(const CollisionManifold& newManifold) noexcept
 			oldContact < oldContacts.data() + oldCount;
 			++oldContact)
 		{
-			if (newManifold.points[i].featurePair ==
-				oldContact->getPoint().featurePair)
+			if (mContacts[i].getFeatureId() == oldContact->getFeatureId())
 			{
 				mContacts[i].updateFrom(*oldContact);
 				break;
@@ -57,23 +91,119 @@ void ContactManifold::update(const CollisionManifold& newManifold) noexcept
 	mObsolete = false;
 }
 
-void ContactManifold::prepareToSolve() noexcept
+uint32_t ContactManifold::prepareToSolve(
+	Real speculativeInvTimeStep,
+	Real invMassScaleA,
+	Real invMassScaleB,
+	const ContactReuseSettings& reuseSettings) noexcept
 {
+	if (!reuseSettings.enabled)
+	{
+		for (ContactPoint* contact = mContacts.data();
+			contact < mContacts.data() + mContactCount;
+			++contact)
+		{
+			contact->prepareToSolve(
+				*mBodyA,
+				*mBodyB,
+				speculativeInvTimeStep,
+				invMassScaleA,
+				invMassScaleB);
+		}
+		mIsPrepared = false;
+		return 0;
+	}
+
+	// The reference poses are kept while the data is reused,
+	// so a slow drift still leads to the preparation
+	const bool canReuse = mIsPrepared && isNearPreparedState(
+		speculativeInvTimeStep,
+		invMassScaleA,
+		invMassScaleB,
+		reuseSettings);
+	if (!canReuse)
+	{
+		mPreparedState = {
+			{ mBodyA->position, mBodyB->position },
+			{ mBodyA->rotation.getAngle(), mBodyB->rotation.getAngle() },
+			{ invMassScaleA, invMassScaleB },
+			speculativeInvTimeStep };
+		mIsPrepared = true;
+	}
+
+	uint32_t result = 0;
 	for (ContactPoint* contact = mContacts.data();
 		contact < mContacts.data() + mContactCount;
 		++contact)
 	{
-		contact->prepareToSolve(*mBodyA, *mBodyB);
+		if (canReuse && contact->canReuseSolverData())
+		{
+			contact->warmStart(*mBodyA, *mBodyB);
+			++result;
+		}
+		else
+		{
+			contact->prepareToSolve(
+				*mBodyA,
+				*mBodyB,
+				speculativeInvTimeStep,
+				invMassScaleA,
+				invMassScaleB);
+		}
+	}
+	return result;
+}
+
+bool ContactManifold::isNearPreparedState(
+	Real speculativeInvTimeStep,
+	Real invMassScaleA,
+	Real invMassScaleB,
+	const ContactReuseSettings& reuseSettings) const noexcept
+{
+	if (speculativeInvTimeStep != mPreparedState.speculativeInvTimeStep ||
+		invMassScaleA != mPreparedState.invMassScales[0] ||
+		invMassScaleB != mPreparedState.invMassScales[1])
+	{
+		return false;
+	}
+
+	const Real maxDistanceSquared = reuseSettings.maxDistance * reuseSettings.maxDistance;
+	const std::array<const Body*, 2> bodies{ mBodyA, mBodyB };
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		if ((bodies[i]->position - mPreparedState.positions[i]).lengthSquared() >
+				maxDistanceSquared ||
+			abs(bodies[i]->rotation.getAngle() - mPreparedState.angles[i]) >
+				reuseSettings.maxAngle)
+		{
+			return false;
+		}
 	}
+	return true;
 }
 
+template <bool WITH_FRICTION>
 void ContactManifold::solveVelocities() noexcept
 {
 	for (ContactPoint* contact = mContacts.data();
 		contact < mContacts.data() + mContactCount;
 		++contact)
 	{
-		contact->solveVelocities(*mBodyA, *mBodyB, mFriction);
+		contact->solveVelocities<WITH_FRICTION>(*mBodyA, *mBodyB, mFriction);
+	}
+}
+
+// Explicit instantiations
+template void ContactManifold::solveVelocities<true>() noexcept;
+template void ContactManifold::solveVelocities<false>() noexcept;
+
+void ContactManifold::solveVelocities(SplitBody& bodyA, SplitBody& bodyB) noexcept
+{
+	for (ContactPoint* contact = mContacts.data();
+		contact < mContacts.data() + mContactCount;
+		++contact)
+	{
+		contact->solveVelocities(bodyA, bodyB, mFriction);
 	}
 }
 
@@ -87,6 +217,44 @@ void ContactManifold::solvePositions() noexcept
 	}
 }
 
+void ContactManifold::solveVelocitiesWithFixedBody(uint32_t fixedBodyIndex) noexcept
+{
+	for (ContactPoint* contact = mContacts.data();
+		contact < mContacts.data() + mContactCount;
+		++contact)
+	{
+		contact->solveVelocitiesWithFixedBody(*mBodyA, *mBodyB, mFriction, fixedBodyIndex);
+	}
+}
+
+Real ContactManifold::getMaxPenetration() const noexcept
+{
+	Real result = -std::numeric_limits<Real>::max();
+	for (const ContactPoint* contact = mContacts.data();
+		contact < mContacts.data() + mContactCount;
+		++contact)
+	{
+		Vec2 normal;
+		Vec2 point;
+		Real penetration;
+		contact->getTransformedContact(*mBodyA, *mBodyB, normal, point, penetration);
+		result = std::max(result, penetration);
+	}
+	return result;
+}
+
+Real ContactManifold::getMaxVelocityError() const noexcept
+{
+	Real result = 0.0f;
+	for (const ContactPoint* contact = mContacts.data();
+		contact < mContacts.data() + mContactCount;
+		++contact)
+	{
+		result = std::max(result, contact->getVelocityError(*mBodyA, *mBodyB));
+	}
+	return result;
+}
+
 void ContactManifold::onBodiesReallocation(
 	std::ptrdiff_t memoryOffsetInBytes) noexcept
 {
@@ -13,8 +13,9 @@ namespace
 {
 
 /// Applies impulse at a point relative to the center of mass
+template <typename BodyType>
 void applyImpulse(
-	Body& body,
+	BodyType& body,
 	const Vec2& localPoint,
 	const Vec2& impulse) noexcept
 {
@@ -23,79 +24,162 @@ void applyImpulse(
 }
 
 /// Computes the effective mass for a given contact and direction
-[[nodiscard]] float getEffectiveMass(
-	const Body& bodyA,
-	const Body& bodyB,
+template <typename BodyType>
+[[nodiscard]] Real getEffectiveMass(
+	const BodyType& bodyA,
+	const BodyType& bodyB,
 	const Vec2& armA,
 	const Vec2& armB,
 	const Vec2& direction) noexcept
 {
-	const float crossA = cross(armA, direction);
-	const float crossB = cross(armB, direction);
-	const float invResult =
+	const Real crossA = cross(armA, direction);
+	const Real crossB = cross(armB, direction);
+	const Real invResult =
 		bodyA.invMass + bodyB.invMass +
 		bodyA.invInertia * crossA * crossA +
 		bodyB.invInertia * crossB * crossB;
 	return 1.0f / invResult;
 }
 
+/// Position correction factor
+constexpr Real POSITION_CORRECTION_FACTOR = 0.2f;
+
+/// Allowed penetration between geometries
+constexpr Real ALLOWED_PENETRATION = 0.001f;
+
 } // anonymous namespace
 
+/// Returns the relative velocity at the contact point
+template <typename BodyType>
+[[nodiscard]] Vec2 ContactPoint::getVelocityAtContact(
+	const BodyType& bodyA,
+	const BodyType& bodyB) const noexcept
+{
+	return
+		bodyB.linearVelocity + cross(bodyB.angularVelocity, mOffsetB) -
+		bodyA.linearVelocity - cross(bodyA.angularVelocity, mOffsetA);
+}
+
+/// Applies an impulse at the contact point
+template <typename BodyType>
+void ContactPoint::applyImpulse(
+	BodyType& bodyA,
+	BodyType& bodyB,
+	const Vec2& impulse) const noexcept
+{
+	nph::applyImpulse(bodyA, mOffsetA, -impulse);
+	nph::applyImpulse(bodyB, mOffsetB,  impulse);
+}
+
+ContactPoint::ContactPoint(const CollisionPoint& inPoint) noexcept
+{
+	// The solver data will be initialized in prepareToSolve
+	// The local contact normal is always an axis of the clipping box,
+	// so it is stored as the axis index and the sign
+	const Vec2& localNormal = inPoint.localContactNormal;
+	const int axis = abs(localNormal.y) > abs(localNormal.x);
+
+	mState.localPoints = inPoint.localPoints;
+	mState.normalImpulse = 0.0f;
+	mState.tangentImpulse = 0.0f;
+	mState.featureId = inPoint.getFeatureId();
+	mIsPrepared = false;
+	mState.flags = static_cast<uint8_t>(
+		inPoint.clipBoxIndex |
+		(axis == 1 ? NORMAL_AXIS_FLAG : 0) |
+		(localNormal[axis] < 0.0f ? NORMAL_SIGN_FLAG : 0));
+}
+
 void ContactPoint::updateFrom(const ContactPoint& other) noexcept
 {
-	mNormalImpulse = other.mNormalImpulse;
-	mTangentImpulse = other.mTangentImpulse;
+	mState.normalImpulse = other.mState.normalImpulse;
+	mState.tangentImpulse = other.mState.tangentImpulse;
+
+	mNormal = other.mNormal;
+	mOffsetA = other.mOffsetA;
+	mOffsetB = other.mOffsetB;
+	mNormalMass = other.mNormalMass;
+	mTangentMass = other.mTangentMass;
+	mGapVelocity = other.mGapVelocity;
+	mIsPrepared = other.mIsPrepared;
 }
 
 void ContactPoint::prepareToSolve(
 	Body& bodyA,
-	Body& bodyB) noexcept
+	Body& bodyB,
+	Real speculativeInvTimeStep,
+	Real invMassScaleA,
+	Real invMassScaleB) noexcept
 {
-	mOffsetA = mPoint.position - bodyA.position;
-	mOffsetB = mPoint.position - bodyB.position;
+	Vec2 position;
+	Real penetration;
+	getTransformedContact(bodyA, bodyB, mNormal, position, penetration);
+	mGapVelocity = std::max(Real(0), -penetration) * speculativeInvTimeStep;
 
-	// Precompute normal mass, tangent mass, and bias.
-	mNormalMass = getEffectiveMass(bodyA, bodyB, mOffsetA, mOffsetB, mPoint.normal);
+	mOffsetA = position - bodyA.position;
+	mOffsetB = position - bodyB.position;
 
-	mTangent = cross(mPoint.normal, 1.0f);
-	mTangentMass = getEffectiveMass(bodyA, bodyB, mOffsetA, mOffsetB, mTangent);
+	// Precompute normal mass, tangent mass, and bias.
+	const SplitBody splitA{
+		bodyA.linearVelocity,
+		bodyA.angularVelocity,
+		invMassScaleA * bodyA.invMass,
+		invMassScaleA * bodyA.invInertia };
+	const SplitBody splitB{
+		bodyB.linearVelocity,
+		bodyB.angularVelocity,
+		invMassScaleB * bodyB.invMass,
+		invMassScaleB * bodyB.invInertia };
+	mNormalMass = getEffectiveMass(splitA, splitB, mOffsetA, mOffsetB, mNormal);
+
+	const Vec2 tangent = cross(mNormal, 1.0f);
+	mTangentMass = getEffectiveMass(splitA, splitB, mOffsetA, mOffsetB, tangent);
+	mIsPrepared = true;
+
+	warmStart(bodyA, bodyB);
+}
 
-	// Apply the warm starting impulse
+void ContactPoint::warmStart(Body& bodyA, Body& bodyB) const noexcept
+{
 	applyImpulse(
 		bodyA,
 		bodyB,
-		mNormalImpulse * mPoint.normal + mTangentImpulse * mTangent);
+		mState.normalImpulse * mNormal + mState.tangentImpulse * cross(mNormal, 1.0f));
 }
 
+template <bool WITH_FRICTION, typename BodyType>
 void ContactPoint::solveVelocities(
-	Body& bodyA,
-	Body& bodyB,
-	float friction) noexcept
+	BodyType& bodyA,
+	BodyType& bodyB,
+	Real friction) noexcept
 {
 	assert(0.0f <= friction && friction <= 1.0f);
 
-	// Normal impulse
+	// Normal impulse; for a speculative contact the bodies
+	// may approach by the gap, so the impulse is not applied earlier
 	{
-		const float impulse = -mNormalMass *
-			dot(getVelocityAtContact(bodyA, bodyB), mPoint.normal);
+		const Real impulse = -mNormalMass *
+			(dot(getVelocityAtContact(bodyA, bodyB), mNormal) + mGapVelocity);
 
-		const float oldImpulse = mNormalImpulse;
-		mNormalImpulse = std::max(0.0f, oldImpulse + impulse);
+		const Real oldImpulse = mState.normalImpulse;
+		mState.normalImpulse = std::max(Real(0), oldImpulse + impulse);
 		applyImpulse(
 			bodyA,
 			bodyB,
-			(mNormalImpulse - oldImpulse) * mPoint.normal);
+			(mState.normalImpulse - oldImpulse) * mNormal);
 	}
 
 	// Dry friction impulse
+	if constexpr (WITH_FRICTION)
 	{
-		const float maxFriction = friction * mNormalImpulse;
+		const Vec2 tangent = cross(mNormal, 1.0f);
+		const Real maxFriction = friction * mState.normalImpulse;
 
-		const float impulse = -mTangentMass *
-			dot(getVelocityAtContact(bodyA, bodyB), mTangent);
+		const Real impulse = -mTangentMass *
+			dot(getVelocityAtContact(bodyA, bodyB), tangent);
 
-		const float oldImpulse = mTangentImpulse;
-		mTangentImpulse = std::clamp(
+		const Real oldImpulse = mState.tangentImpulse;
+		mState.tangentImpulse = std::clamp(
 			oldImpulse + impulse,
 			-maxFriction,
 			maxFriction);
@@ -103,39 +187,53 @@ void ContactPoint::solveVelocities(
 		applyImpulse(
 			bodyA,
 			bodyB,
-			(mTangentImpulse - oldImpulse) * mTangent);
+			(mState.tangentImpulse - oldImpulse) * tangent);
 	}
 }
 
+// Explicit instantiations
+template void ContactPoint::solveVelocities<true>(Body&, Body&, Real) noexcept;
+template void ContactPoint::solveVelocities<false>(Body&, Body&, Real) noexcept;
+template void ContactPoint::solveVelocities<true>(SplitBody&, SplitBody&, Real) noexcept;
+template void ContactPoint::solveVelocities<false>(SplitBody&, SplitBody&, Real) noexcept;
+
+void ContactPoint::setImpulses(
+	Body& bodyA,
+	Body& bodyB,
+	Real normalImpulse,
+	Real tangentImpulse) noexcept
+{
+	applyImpulse(
+		bodyA,
+		bodyB,
+		(normalImpulse - mState.normalImpulse) * mNormal +
+		(tangentImpulse - mState.tangentImpulse) * cross(mNormal, 1.0f));
+	mState.normalImpulse = normalImpulse;
+	mState.tangentImpulse = tangentImpulse;
+}
+
 void ContactPoint::solvePositions(
 	Body& bodyA,
 	Body& bodyB) noexcept
 {
 	// This method is similar to the position based dynamics (PBD) approach :
 	// we directly modify the positions and rotations of the bodies
-
-	// Position correction factor
-	static constexpr float POSITION_CORRECTION_FACTOR = 0.2f;
-
-	// Allowed penetration between geometries
-	static constexpr float ALLOWED_PENETRATION = 0.001f;
-
 	Vec2 normal;
-	float penetration;
+	Real penetration;
 	Vec2 planePoint;
 	getTransformedContact(bodyA, bodyB, normal, planePoint, penetration);
 
-	const float biasFactor = std::max(
-		0.0f,
+	const Real biasFactor = std::max(
+		Real(0),
 		POSITION_CORRECTION_FACTOR * (penetration - ALLOWED_PENETRATION));
 
 	const Vec2 offsetA = planePoint - bodyA.position;
 	const Vec2 offsetB = planePoint - bodyB.position;
 
-	const float effectiveMass =
+	const Real effectiveMass =
 		getEffectiveMass(bodyA, bodyB, offsetA, offsetB, normal);
 
-	const Vec2 penetrationImpulse = std::max(0.0f, effectiveMass * biasFactor) * normal;
+	const Vec2 penetrationImpulse = std::max(Real(0), effectiveMass * biasFactor) * normal;
 
 	// Directly integrate positions and rotations of the bodies in contact
 	bodyA.position -= bodyA.invMass * penetrationImpulse;
@@ -147,24 +245,115 @@ void ContactPoint::solvePositions(
 		bodyB.invInertia * cross(offsetB, penetrationImpulse));
 }
 
-/// Returns the relative velocity at the contact point
-[[nodiscard]] Vec2 ContactPoint::getVelocityAtContact(
+void ContactPoint::preparePseudoVelocities(
+	const Body& bodyA,
+	const Body& bodyB,
+	PseudoContact& pseudoContact) const noexcept
+{
+	Vec2 planePoint;
+	getTransformedContact(
+		bodyA,
+		bodyB,
+		pseudoContact.normal,
+		planePoint,
+		pseudoContact.penetration);
+
+	pseudoContact.offsetA = planePoint - bodyA.position;
+	pseudoContact.offsetB = planePoint - bodyB.position;
+	pseudoContact.normalMass = getEffectiveMass(
+		bodyA,
+		bodyB,
+		pseudoContact.offsetA,
+		pseudoContact.offsetB,
+		pseudoContact.normal);
+}
+
+void ContactPoint::solvePseudoVelocities(
+	const PseudoContact& pseudoContact,
+	SplitBody& bodyA,
+	SplitBody& bodyB) noexcept
+{
+	// The displacement of the contact points along the normal
+	// reduces the prepared penetration
+	const Vec2 displacement =
+		bodyB.linearVelocity + cross(bodyB.angularVelocity, pseudoContact.offsetB) -
+		bodyA.linearVelocity - cross(bodyA.angularVelocity, pseudoContact.offsetA);
+	const Real penetration =
+		pseudoContact.penetration - dot(displacement, pseudoContact.normal);
+
+	const Real biasFactor = std::max(
+		Real(0),
+		POSITION_CORRECTION_FACTOR * (penetration - ALLOWED_PENETRATION));
+
+	const Vec2 penetrationImpulse =
+		(pseudoContact.normalMass * biasFactor) * pseudoContact.normal;
+
+	nph::applyImpulse(bodyA, pseudoContact.offsetA, -penetrationImpulse);
+	nph::applyImpulse(bodyB, pseudoContact.offsetB, penetrationImpulse);
+}
+
+Real ContactPoint::getVelocityError(
 	const Body& bodyA,
 	const Body& bodyB) const noexcept
 {
-	return
-		bodyB.linearVelocity + cross(bodyB.angularVelocity, mOffsetB) -
-		bodyA.linearVelocity - cross(bodyA.angularVelocity, mOffsetA);
+	const Real normalVelocity =
+		dot(getVelocityAtContact(bodyA, bodyB), mNormal) + mGapVelocity;
+	return mState.normalImpulse > 0.0f ?
+		abs(normalVelocity) :
+		std::max(Real(0), -normalVelocity);
 }
 
-/// Applies an impulse at the contact point
-void ContactPoint::applyImpulse(
+void ContactPoint::solveVelocitiesWithFixedBody(
 	Body& bodyA,
 	Body& bodyB,
-	const Vec2& impulse) const noexcept
+	Real friction,
+	uint32_t fixedBodyIndex) noexcept
 {
-	nph::applyImpulse(bodyA, mOffsetA, -impulse);
-	nph::applyImpulse(bodyB, mOffsetB,  impulse);
+	assert(0.0f <= friction && friction <= 1.0f);
+	assert(fixedBodyIndex < 2);
+
+	// The inverse mass and inertia of the fixed body are zeroed
+	const Real scaleA(fixedBodyIndex != 0);
+	const Real scaleB(fixedBodyIndex != 1);
+	const auto getScaledEffectiveMass = [&](const Vec2& direction)
+	{
+		const Real crossA = cross(mOffsetA, direction);
+		const Real crossB = cross(mOffsetB, direction);
+		return 1.0f / (
+			scaleA * (bodyA.invMass + bodyA.invInertia * crossA * crossA) +
+			scaleB * (bodyB.invMass + bodyB.invInertia * crossB * crossB));
+	};
+	const auto applyScaledImpulse = [&](const Vec2& impulse)
+	{
+		nph::applyImpulse(bodyA, mOffsetA, -scaleA * impulse);
+		nph::applyImpulse(bodyB, mOffsetB, scaleB * impulse);
+	};
+
+	// The impulses are accumulated as by solveVelocities, so the iterations
+	// can take back the excess of the warm starting and of the previous ones
+	{
+		const Real impulse = -getScaledEffectiveMass(mNormal) *
+			(dot(getVelocityAtContact(bodyA, bodyB), mNormal) + mGapVelocity);
+
+		const Real oldImpulse = mState.normalImpulse;
+		mState.normalImpulse = std::max(Real(0), oldImpulse + impulse);
+		applyScaledImpulse((mState.normalImpulse - oldImpulse) * mNormal);
+	}
+
+	{
+		const Vec2 tangent = cross(mNormal, 1.0f);
+		const Real maxFriction = friction * mState.normalImpulse;
+
+		const Real impulse = -getScaledEffectiveMass(tangent) *
+			dot(getVelocityAtContact(bodyA, bodyB), tangent);
+
+		const Real oldImpulse = mState.tangentImpulse;
+		mState.tangentImpulse = std::clamp(
+			oldImpulse + impulse,
+			-maxFriction,
+			maxFriction);
+		applyScaledImpulse((mState.tangentImpulse - oldImpulse) * tangent);
+	}
 }
 
 void ContactPoint::getTransformedContact(
@@ -172,29 +361,30 @@ void ContactPoint::getTransformedContact(
 	const Body& bodyB,
 	Vec2& normal,
 	Vec2& clippedPoint,
-	float& penetration) const
+	Real& penetration) const noexcept
 {
 	const std::array<Vec2, 2> positions{
 		bodyA.position,
 		bodyB.position };
 
-	const std::array<Mat22, 2> rotations{
-		bodyA.rotation.getMat(),
-		bodyB.rotation.getMat() };
+	const std::array<const Mat22*, 2> rotations{
+		&bodyA.rotation.getMat(),
+		&bodyB.rotation.getMat() };
 
-	const CollisionPoint& contact = mPoint;
-	const uint32_t ind1 = contact.clipBoxIndex;
+	const uint32_t ind1 = getClipBoxIndex();
 	const uint32_t ind2 = 1 - ind1;
 
 	clippedPoint =
 		positions[ind2] +
-		rotations[ind2] * contact.localPoints[ind2];
+		*rotations[ind2] * mState.localPoints[ind2];
 
-	normal = rotations[ind1] * contact.localContactNormal;
+	const Vec2& clipAxis =
+		(*rotations[ind1])[(mState.flags & NORMAL_AXIS_FLAG) ? 1 : 0];
+	normal = (mState.flags & NORMAL_SIGN_FLAG) ? -clipAxis : clipAxis;
 
 	const Vec2 planePoint =
 		positions[ind1] +
-		rotations[ind1] * contact.localPoints[ind1];
+		*rotations[ind1] * mState.localPoints[ind1];
 
 	penetration = dot(planePoint - clippedPoint, normal);
 
@@ -4,6 +4,7 @@
 
 // Includes
 #include "neat_physics/dynamics/ContactSolver.h"
+#include <algorithm>
 
 namespace nph
 {
@@ -17,6 +18,7 @@ void ContactSolver::clear() noexcept
 {
 	mContactPairs.clear();
 	mManifolds.clear();
+	mShockOrder.clear();
 }
 
 void ContactSolver::onBodiesReallocation(std::ptrdiff_t memoryOffsetInBytes) noexcept
@@ -27,11 +29,75 @@ void ContactSolver::onBodiesReallocation(std::ptrdiff_t memoryOffsetInBytes) noe
 	}
 }
 
-void ContactSolver::prepareToSolve() noexcept
+Real ContactSolver::getMaxPenetration() const noexcept
 {
-	for (auto& pair : mManifolds)
+	Real result = 0.0f;
+	for (const auto& pair : mManifolds)
+	{
+		result = std::max(result, pair.second.getMaxPenetration());
+	}
+	return result;
+}
+
+Real ContactSolver::getMaxVelocityError() const noexcept
+{
+	Real result = 0.0f;
+	for (const auto& pair : mManifolds)
+	{
+		result = std::max(result, pair.second.getMaxVelocityError());
+	}
+	return result;
+}
+
+void ContactSolver::prepareToSolve(
+	Real speculativeInvTimeStep,
+	VelocitySolver velocitySolver,
+	Real jacobiRelaxation,
+	const ContactReuseSettings& reuseSettings)
+{
+	mContactCount = 0;
+	mReusedContactCount = 0;
+	for (const auto& pair : mManifolds)
 	{
-		pair.second.prepareToSolve();
+		mContactCount += pair.second.getContactCount();
+	}
+
+	if (velocitySolver == VelocitySolver::GAUSS_SEIDEL)
+	{
+		for (auto& pair : mManifolds)
+		{
+			mReusedContactCount += pair.second.prepareToSolve(
+				speculativeInvTimeStep,
+				1.0f,
+				1.0f,
+				reuseSettings);
+		}
+		return;
+	}
+
+	// The relaxed Jacobi iteration divides all masses by the inverse
+	// relaxation, so the contacts accumulate the impulses actually applied
+	// to the bodies
+	assert(velocitySolver == VelocitySolver::JACOBI);
+	assert(0.0f < jacobiRelaxation && jacobiRelaxation <= 1.0f);
+	mSplitCount = 1.0f / jacobiRelaxation;
+	mSplitShare = 1.0f / mSplitCount;
+
+	// The scaled inverse masses of the copies are constant during the step
+	mSplitBodies.resize(mManifolds.size() * 2);
+	for (size_t mi = 0; mi < mManifolds.size(); ++mi)
+	{
+		ContactManifold& manifold = mManifolds[mi].second;
+		mReusedContactCount += manifold.prepareToSolve(
+			speculativeInvTimeStep,
+			mSplitCount,
+			mSplitCount,
+			reuseSettings);
+
+		mSplitBodies[mi * 2].invMass = mSplitCount * manifold.getBodyA().invMass;
+		mSplitBodies[mi * 2].invInertia = mSplitCount * manifold.getBodyA().invInertia;
+		mSplitBodies[mi * 2 + 1].invMass = mSplitCount * manifold.getBodyB().invMass;
+		mSplitBodies[mi * 2 + 1].invInertia = mSplitCount * manifold.getBodyB().invInertia;
 	}
 }
 
@@ -46,6 +112,110 @@ void ContactSolver::solveVelocities(uint32_t velocityIterations) noexcept
 	}
 }
 
+void ContactSolver::solveVelocitiesWithDirectSolve(
+	uint32_t velocityIterations,
+	uint32_t maxDirectConstraints)
+{
+	mDirectSolveStats = {};
+	if (velocityIterations == 0)
+	{
+		return;
+	}
+
+	buildIslands();
+	mIterativeManifolds.clear();
+	for (uint32_t island = 0; island < mIslands.getIslandCount(); ++island)
+	{
+		const std::span<const uint32_t> islandManifolds =
+			mIslands.getIslandManifolds(island);
+
+		uint32_t constraintCount = 0;
+		for (const uint32_t manifoldIndex : islandManifolds)
+		{
+			constraintCount += 2 * mManifolds[manifoldIndex].second.getContactCount();
+		}
+		if (constraintCount > maxDirectConstraints)
+		{
+			mIterativeManifolds.insert(
+				mIterativeManifolds.end(),
+				islandManifolds.begin(),
+				islandManifolds.end());
+			continue;
+		}
+
+		mDirectManifolds.clear();
+		for (const uint32_t manifoldIndex : islandManifolds)
+		{
+			mDirectManifolds.push_back(&mManifolds[manifoldIndex].second);
+		}
+		const uint32_t iterationCount = mDirectSolver.solve(mDirectManifolds);
+		++mDirectSolveStats.islandCount;
+		mDirectSolveStats.maxIterationCount = std::max(
+			mDirectSolveStats.maxIterationCount,
+			iterationCount);
+	}
+
+	// The islands do not share dynamic bodies, so the large ones are solved
+	// exactly as by solveVelocities if the manifold order is kept
+	std::sort(mIterativeManifolds.begin(), mIterativeManifolds.end());
+	for (uint32_t i = 0; i < velocityIterations; ++i)
+	{
+		for (const uint32_t manifoldIndex : mIterativeManifolds)
+		{
+			mManifolds[manifoldIndex].second.solveVelocities();
+		}
+	}
+}
+
+void ContactSolver::solveVelocitiesWithCopies(uint32_t velocityIterations) noexcept
+{
+	assert(mSplitBodies.size() == mManifolds.size() * 2);
+	for (uint32_t i = 0; i < velocityIterations; ++i)
+	{
+		// All manifolds start from the same velocities
+		for (size_t mi = 0; mi < mManifolds.size(); ++mi)
+		{
+			ContactManifold& manifold = mManifolds[mi].second;
+			const Body& bodyA = manifold.getBodyA();
+			const Body& bodyB = manifold.getBodyB();
+
+			SplitBody& splitA = mSplitBodies[mi * 2];
+			SplitBody& splitB = mSplitBodies[mi * 2 + 1];
+			splitA.linearVelocity = bodyA.linearVelocity;
+			splitA.angularVelocity = bodyA.angularVelocity;
+			splitB.linearVelocity = bodyB.linearVelocity;
+			splitB.angularVelocity = bodyB.angularVelocity;
+			manifold.solveVelocities(splitA, splitB);
+
+			splitA.linearVelocity -= bodyA.linearVelocity;
+			splitA.angularVelocity -= bodyA.angularVelocity;
+			splitB.linearVelocity -= bodyB.linearVelocity;
+			splitB.angularVelocity -= bodyB.angularVelocity;
+		}
+
+		// Sum the velocity changes in the manifold order, each copy
+		// contributes its share 1 / count, i.e. the relaxation
+		for (size_t mi = 0; mi < mManifolds.size(); ++mi)
+		{
+			const ContactManifold& manifold = mManifolds[mi].second;
+			const std::array<uint32_t, 2> bodyIndices{
+				getBodyIndex(manifold.getBodyA()),
+				getBodyIndex(manifold.getBodyB()) };
+			for (uint32_t bi = 0; bi < 2; ++bi)
+			{
+				Body& body = mBodies[bodyIndices[bi]];
+				if (body.isStatic())
+				{
+					continue;
+				}
+				const SplitBody& delta = mSplitBodies[mi * 2 + bi];
+				body.linearVelocity += mSplitShare * delta.linearVelocity;
+				body.angularVelocity += mSplitShare * delta.angularVelocity;
+			}
+		}
+	}
+}
+
 void ContactSolver::solvePositions(uint32_t positionIterations) noexcept
 {
 	for (uint32_t i = 0; i < positionIterations; ++i)
@@ -57,6 +227,257 @@ void ContactSolver::solvePositions(uint32_t positionIterations) noexcept
 	}
 }
 
+void ContactSolver::solvePositionsWithPseudoVelocities(uint32_t positionIterations)
+{
+	if (positionIterations == 0)
+	{
+		return;
+	}
+
+	// The contacts are transformed for the poses at the start only
+	mPseudoContacts.clear();
+	mPseudoContactBodies.clear();
+	for (const auto& pair : mManifolds)
+	{
+		const ContactManifold& manifold = pair.second;
+		const std::pair<uint32_t, uint32_t> bodyIndices{
+			getBodyIndex(manifold.getBodyA()),
+			getBodyIndex(manifold.getBodyB()) };
+		for (uint32_t ci = 0; ci < manifold.getContactCount(); ++ci)
+		{
+			manifold.getContact(ci).preparePseudoVelocities(
+				manifold.getBodyA(),
+				manifold.getBodyB(),
+				mPseudoContacts.emplace_back());
+			mPseudoContactBodies.push_back(bodyIndices);
+		}
+	}
+
+	mPseudoBodies.resize(mBodies.size());
+	for (size_t bi = 0; bi < mBodies.size(); ++bi)
+	{
+		mPseudoBodies[bi] = {
+			{ 0.0f, 0.0f },
+			0.0f,
+			mBodies[bi].invMass,
+			mBodies[bi].invInertia };
+	}
+
+	for (uint32_t i = 0; i < positionIterations; ++i)
+	{
+		for (size_t ci = 0; ci < mPseudoContacts.size(); ++ci)
+		{
+			ContactPoint::solvePseudoVelocities(
+				mPseudoContacts[ci],
+				mPseudoBodies[mPseudoContactBodies[ci].first],
+				mPseudoBodies[mPseudoContactBodies[ci].second]);
+		}
+	}
+
+	// A single rotation update per corrected body
+	for (size_t bi = 0; bi < mBodies.size(); ++bi)
+	{
+		Body& body = mBodies[bi];
+		const SplitBody& correction = mPseudoBodies[bi];
+		body.position += correction.linearVelocity;
+		if (correction.angularVelocity != 0.0f)
+		{
+			body.rotation.setAngle(body.rotation.getAngle() + correction.angularVelocity);
+		}
+	}
+}
+
+void ContactSolver::getBodyPairs(
+	std::vector<std::pair<uint32_t, uint32_t>>& pairs) const
+{
+	pairs.resize(mManifolds.size());
+	for (size_t i = 0; i < mManifolds.size(); ++i)
+	{
+		const uint64_t key = mManifolds[i].first->first;
+		pairs[i] = {
+			static_cast<uint32_t>(key >> 32),
+			static_cast<uint32_t>(key) };
+	}
+}
+
+void ContactSolver::buildIslands()
+{
+	getBodyPairs(mBodyPairs);
+	mIslands.build(mBodies, mBodyPairs);
+}
+
+Real ContactSolver::getIslandMassRatio(
+	const IslandBuilder& islands,
+	uint32_t islandIndex) const noexcept
+{
+	Real minMass = std::numeric_limits<Real>::max();
+	Real maxMass = 0.0f;
+	for (const uint32_t manifoldIndex : islands.getIslandManifolds(islandIndex))
+	{
+		const ContactManifold& manifold = mManifolds[manifoldIndex].second;
+		for (const Body* body : { &manifold.getBodyA(), &manifold.getBodyB() })
+		{
+			if (!body->isStatic())
+			{
+				minMass = std::min(minMass, body->mass);
+				maxMass = std::max(maxMass, body->mass);
+			}
+		}
+	}
+	return maxMass / minMass;
+}
+
+void ContactSolver::getIslandMassRatios(std::vector<Real>& ratios) const
+{
+	// The islands are built anew, so the method does not change the solver
+	std::vector<std::pair<uint32_t, uint32_t>> bodyPairs;
+	getBodyPairs(bodyPairs);
+	IslandBuilder islands;
+	islands.build(mBodies, bodyPairs);
+
+	ratios.resize(islands.getIslandCount());
+	for (uint32_t island = 0; island < islands.getIslandCount(); ++island)
+	{
+		ratios[island] = getIslandMassRatio(islands, island);
+	}
+}
+
+void ContactSolver::prepareShockPropagation(const Vec2& gravity)
+{
+	// Cosine of the maximum angle between a supporting contact normal
+	// and the gravity, about 45 degrees
+	static constexpr Real SUPPORT_NORMAL_COSINE = 0.7f;
+
+	// Supporting body of each manifold (0 - 1): the one below the other
+	// along the gravity, NO_FIXED_BODY for the side contacts
+	const Vec2 up = -gravity.getNormalized();
+	getBodyPairs(mBodyPairs);
+	mSupportingBodies.resize(mManifolds.size());
+	for (size_t mi = 0; mi < mManifolds.size(); ++mi)
+	{
+		const ContactManifold& manifold = mManifolds[mi].second;
+		Vec2 normal;
+		Vec2 point;
+		Real penetration;
+		manifold.getContact(0).getTransformedContact(
+			manifold.getBodyA(), manifold.getBodyB(), normal, point, penetration);
+
+		// The normal points from A to B
+		const Real normalUp = dot(normal, up);
+		mSupportingBodies[mi] =
+			normalUp > SUPPORT_NORMAL_COSINE ? 0 :
+			normalUp < -SUPPORT_NORMAL_COSINE ? 1 :
+			NO_FIXED_BODY;
+	}
+
+	// Support graph: the bodies supported by body i are mBodyNeighbors
+	// in [mBodyNeighborStarts[i], mBodyNeighborStarts[i + 1])
+	mBodyNeighborStarts.assign(mBodies.size() + 1, 0);
+	for (size_t mi = 0; mi < mManifolds.size(); ++mi)
+	{
+		if (mSupportingBodies[mi] != NO_FIXED_BODY)
+		{
+			const auto& [bodyA, bodyB] = mBodyPairs[mi];
+			++mBodyNeighborStarts[(mSupportingBodies[mi] == 0 ? bodyA : bodyB) + 1];
+		}
+	}
+	for (size_t bi = 0; bi < mBodies.size(); ++bi)
+	{
+		mBodyNeighborStarts[bi + 1] += mBodyNeighborStarts[bi];
+	}
+	mBodyNeighbors.resize(mBodyNeighborStarts.back());
+	mBodyNeighborEnds.assign(mBodyNeighborStarts.begin(), mBodyNeighborStarts.end() - 1);
+	for (size_t mi = 0; mi < mManifolds.size(); ++mi)
+	{
+		if (mSupportingBodies[mi] != NO_FIXED_BODY)
+		{
+			const auto& [bodyA, bodyB] = mBodyPairs[mi];
+			const bool isSupportA = mSupportingBodies[mi] == 0;
+			mBodyNeighbors[mBodyNeighborEnds[isSupportA ? bodyA : bodyB]++] =
+				isSupportA ? bodyB : bodyA;
+		}
+	}
+
+	// Breadth-first search from the static bodies: the level of a dynamic body
+	// is the smallest number of supporting contacts between it
+	// and a static body
+	mBodyLevels.assign(mBodies.size(), UNSUPPORTED_LEVEL);
+	mLevelQueue.clear();
+	for (uint32_t bi = 0; bi < mBodies.size(); ++bi)
+	{
+		if (mBodies[bi].isStatic())
+		{
+			mBodyLevels[bi] = 0;
+			mLevelQueue.push_back(bi);
+		}
+	}
+	for (size_t qi = 0; qi < mLevelQueue.size(); ++qi)
+	{
+		const uint32_t bodyIndex = mLevelQueue[qi];
+		for (uint32_t ni = mBodyNeighborStarts[bodyIndex];
+			ni < mBodyNeighborStarts[bodyIndex + 1];
+			++ni)
+		{
+			const uint32_t neighbor = mBodyNeighbors[ni];
+			if (mBodyLevels[neighbor] == UNSUPPORTED_LEVEL)
+			{
+				mBodyLevels[neighbor] = mBodyLevels[bodyIndex] + 1;
+				mLevelQueue.push_back(neighbor);
+			}
+		}
+	}
+
+	// The lower-level body of a supporting manifold is fixed: by the search,
+	// it is the supporting one, so no body is pushed down by a fixed body.
+	// The side manifolds, the ones between bodies of the same level
+	// and the ones with a static body are solved as usual.
+	mShockOrder.resize(mManifolds.size());
+	for (uint32_t mi = 0; mi < mManifolds.size(); ++mi)
+	{
+		const auto& [bodyA, bodyB] = mBodyPairs[mi];
+		const std::array<uint32_t, 2> levels{ mBodyLevels[bodyA], mBodyLevels[bodyB] };
+		const uint32_t supportIndex = mSupportingBodies[mi];
+		uint32_t fixedBodyIndex = NO_FIXED_BODY;
+		if (supportIndex != NO_FIXED_BODY &&
+			levels[supportIndex] != 0 &&
+			levels[supportIndex] < levels[1 - supportIndex])
+		{
+			fixedBodyIndex = supportIndex;
+		}
+		mShockOrder[mi] = { mi, fixedBodyIndex, std::min(levels[0], levels[1]) };
+	}
+
+	// From the static bodies upwards, the ties in the manifold order
+	std::sort(
+		mShockOrder.begin(),
+		mShockOrder.end(),
+		[](const ShockManifold& a, const ShockManifold& b)
+		{
+			return a.level < b.level ||
+				(a.level == b.level && a.manifoldIndex < b.manifoldIndex);
+		});
+}
+
+void ContactSolver::solveVelocitiesWithShock(uint32_t velocityIterations) noexcept
+{
+	assert(mShockOrder.size() == mManifolds.size());
+	for (uint32_t i = 0; i < velocityIterations; ++i)
+	{
+		for (const ShockManifold& shock : mShockOrder)
+		{
+			ContactManifold& manifold = mManifolds[shock.manifoldIndex].second;
+			if (shock.fixedBodyIndex == NO_FIXED_BODY)
+			{
+				manifold.solveVelocities();
+			}
+			else
+			{
+				manifold.solveVelocitiesWithFixedBody(shock.fixedBodyIndex);
+			}
+		}
+	}
+}
+
 void ContactSolver::prepareManifoldsUpdate() noexcept
 {
 	for (auto& pair : mManifolds)
@@ -116,4 +537,57 @@ void ContactSolver::finishManifoldsUpdate()
 	}
 }
 
+void ContactSolver::getManifoldRecords(ManifoldRecordArray& records) const
+{
+	records.clear();
+	records.reserve(mManifolds.size());
+	for (const auto& [pairIter, manifold] : mManifolds)
+	{
+		records.push_back({ pairIter->first, manifold.getState() });
+	}
+}
+
+bool ContactSolver::setManifolds(std::span<const ManifoldRecord> records)
+{
+	clear();
+	if (records.size() > std::numeric_limits<uint32_t>::max())
+	{
+		return false;
+	}
+
+	mManifolds.reserve(records.size());
+	mContactPairs.reserve(records.size());
+	for (const ManifoldRecord& record : records)
+	{
+		const uint32_t bodyIndA = static_cast<uint32_t>(record.bodyPairKey >> 32);
+		const uint32_t bodyIndB = static_cast<uint32_t>(record.bodyPairKey);
+		const uint32_t contactCount = record.state.contactCount;
+		if (bodyIndA >= bodyIndB ||
+			bodyIndB >= mBodies.size() ||
+			contactCount == 0 ||
+			contactCount > MAX_COLLISION_POINTS)
+		{
+			clear();
+			return false;
+		}
+
+		const auto [pairIter, inserted] = mContactPairs.try_emplace(
+			record.bodyPairKey,
+			static_cast<uint32_t>(mManifolds.size()));
+		if (!inserted)
+		{
+			clear();
+			return false;
+		}
+		mManifolds.emplace_back(
+			std::piecewise_construct,
+			std::forward_as_tuple(pairIter),
+			std::forward_as_tuple(
+				mBodies[bodyIndA],
+				mBodies[bodyIndB],
+				record.state));
+	}
+	return true;
+}
+
 } // namespace nph
@@ -0,0 +1,413 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "neat_physics/dynamics/DirectSolver.h"
+#include <algorithm>
+
+namespace nph
+{
+
+uint32_t DirectSolver::addBody(const Body& body)
+{
+	if (body.isStatic())
+	{
+		return NO_BODY;
+	}
+
+	// The islands are small, so the linear search is fine
+	const auto found = std::find(mBodies.begin(), mBodies.end(), &body);
+	if (found != mBodies.end())
+	{
+		return static_cast<uint32_t>(found - mBodies.begin());
+	}
+	mBodies.push_back(&body);
+	return static_cast<uint32_t>(mBodies.size()) - 1;
+}
+
+Real DirectSolver::getMatrixElement(
+	const Row& rowI,
+	const Row& rowJ) const noexcept
+{
+	Real result = 0.0f;
+	for (uint32_t a = 0; a < 2; ++a)
+	{
+		if (rowI.bodies[a] == NO_BODY)
+		{
+			continue;
+		}
+		for (uint32_t b = 0; b < 2; ++b)
+		{
+			if (rowI.bodies[a] == rowJ.bodies[b])
+			{
+				const Body& body = *mBodies[rowI.bodies[a]];
+				result +=
+					body.invMass * dot(rowI.linear[a], rowJ.linear[b]) +
+					body.invInertia * rowI.angular[a] * rowJ.angular[b];
+			}
+		}
+	}
+	return result;
+}
+
+Real DirectSolver::getVelocity(
+	size_t row,
+	const std::vector<Real>& impulseChanges) const noexcept
+{
+	const size_t rowCount = mRows.size();
+	const Real* matrixRow = mMatrix.data() + row * rowCount;
+	Real result = mVelocities[row];
+	for (size_t j = 0; j < rowCount; ++j)
+	{
+		result += matrixRow[j] * impulseChanges[j];
+	}
+	return result;
+}
+
+bool DirectSolver::iterate(uint32_t iterations, uint32_t& iterationCount) noexcept
+{
+	// The normal impulses are non-negative,
+	// the friction impulses are bounded by the normal ones
+	const size_t rowCount = mRows.size();
+	for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+	{
+		++iterationCount;
+		Real maxVelocityChange = 0.0f;
+		for (size_t i = 0; i < rowCount; ++i)
+		{
+			const Real diagonal = mMatrix[i * rowCount + i];
+			if (diagonal <= 0.0f)
+			{
+				continue;
+			}
+
+			Real impulse = mImpulses[i] - getVelocity(i, mImpulseChanges) / diagonal;
+			if (i % 2 == 0)
+			{
+				impulse = std::max(Real(0), impulse);
+			}
+			else
+			{
+				const Real maxFriction = mFrictions[i / 2] * mImpulses[i - 1];
+				impulse = std::clamp(impulse, -maxFriction, maxFriction);
+			}
+
+			const Real change = impulse - mImpulses[i];
+			mImpulses[i] = impulse;
+			mImpulseChanges[i] += change;
+			maxVelocityChange = std::max(maxVelocityChange, abs(change) * diagonal);
+		}
+
+		if (maxVelocityChange <= VELOCITY_TOLERANCE)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool DirectSolver::solveActiveSet()
+{
+	// Guess the states: the pushing contacts stick unless
+	// the friction impulse is at the bound
+	const size_t contactCount = mRows.size() / 2;
+	mContactStates.resize(contactCount);
+	for (size_t k = 0; k < contactCount; ++k)
+	{
+		const Real normalImpulse = mImpulses[2 * k];
+		const Real tangentImpulse = mImpulses[2 * k + 1];
+		if (normalImpulse <= 0.0f)
+		{
+			mContactStates[k] = ContactState::SEPARATED;
+		}
+		else if (abs(tangentImpulse) < mFrictions[k] * normalImpulse)
+		{
+			mContactStates[k] = ContactState::STICKING;
+		}
+		else
+		{
+			mContactStates[k] = tangentImpulse > 0.0f ?
+				ContactState::SLIDING_POSITIVE :
+				ContactState::SLIDING_NEGATIVE;
+		}
+	}
+
+	for (uint32_t pivot = 0; pivot < MAX_PIVOTS; ++pivot)
+	{
+		bool isFailed = false;
+		if (!solveLinearSystem())
+		{
+			return false;
+		}
+		if (updateContactStates(isFailed))
+		{
+			for (size_t k = 0; k < contactCount; ++k)
+			{
+				const Real maxFriction = mFrictions[k] * mSolution[2 * k];
+				const Real tangentImpulse = std::clamp(
+					mSolution[2 * k + 1],
+					-maxFriction,
+					maxFriction);
+				mSolutionChanges[2 * k + 1] += tangentImpulse - mSolution[2 * k + 1];
+				mSolution[2 * k + 1] = tangentImpulse;
+			}
+			mImpulses.swap(mSolution);
+			mImpulseChanges.swap(mSolutionChanges);
+			return true;
+		}
+		if (isFailed)
+		{
+			return false;
+		}
+	}
+	return false;
+}
+
+bool DirectSolver::solveLinearSystem()
+{
+	// The unknowns are the normal impulses of the pushing contacts
+	// and the friction impulses of the sticking ones
+	const size_t rowCount = mRows.size();
+	const size_t contactCount = rowCount / 2;
+	mUnknowns.clear();
+	for (size_t k = 0; k < contactCount; ++k)
+	{
+		if (mContactStates[k] != ContactState::SEPARATED)
+		{
+			mUnknowns.push_back(static_cast<uint32_t>(2 * k));
+		}
+		if (mContactStates[k] == ContactState::STICKING)
+		{
+			mUnknowns.push_back(static_cast<uint32_t>(2 * k + 1));
+		}
+	}
+
+	// The velocities of the unknowns vanish; the sliding friction impulse
+	// is the friction times its normal impulse, so it adds to the column
+	// of the normal. The right side is for the whole impulses, not the changes.
+	const size_t unknownCount = mUnknowns.size();
+	const size_t width = unknownCount + 1;
+	mSystem.assign(unknownCount * width, 0.0f);
+	for (size_t r = 0; r < unknownCount; ++r)
+	{
+		const uint32_t i = mUnknowns[r];
+		const Real* matrixRow = mMatrix.data() + i * rowCount;
+		Real* systemRow = mSystem.data() + r * width;
+		for (size_t c = 0; c < unknownCount; ++c)
+		{
+			const uint32_t j = mUnknowns[c];
+			systemRow[c] = matrixRow[j];
+			if (j % 2 == 0)
+			{
+				systemRow[c] +=
+					getSlidingSign(j / 2) * mFrictions[j / 2] * matrixRow[j + 1];
+			}
+		}
+		systemRow[r] += REGULARIZATION * matrixRow[i];
+
+		Real rightSide = -mVelocities[i];
+		for (size_t j = 0; j < rowCount; ++j)
+		{
+			rightSide += matrixRow[j] * (mImpulses[j] - mImpulseChanges[j]);
+		}
+		systemRow[unknownCount] = rightSide;
+	}
+
+	// Gaussian elimination with the partial pivoting
+	for (size_t c = 0; c < unknownCount; ++c)
+	{
+		size_t pivot = c;
+		for (size_t r = c + 1; r < unknownCount; ++r)
+		{
+			if (abs(mSystem[r * width + c]) > abs(mSystem[pivot * width + c]))
+			{
+				pivot = r;
+			}
+		}
+		if (mSystem[pivot * width + c] == 0.0f)
+		{
+			return false;
+		}
+		if (pivot != c)
+		{
+			std::swap_ranges(
+				mSystem.begin() + pivot * width,
+				mSystem.begin() + (pivot + 1) * width,
+				mSystem.begin() + c * width);
+		}
+
+		const Real* pivotRow = mSystem.data() + c * width;
+		for (size_t r = c + 1; r < unknownCount; ++r)
+		{
+			Real* systemRow = mSystem.data() + r * width;
+			const Real factor = systemRow[c] / pivotRow[c];
+			for (size_t k = c; k < width; ++k)
+			{
+				systemRow[k] -= factor * pivotRow[k];
+			}
+		}
+	}
+
+	// Back substitution; the impulses out of the unknowns vanish
+	// or are the sliding friction
+	mSolution.assign(rowCount, 0.0f);
+	for (size_t r = unknownCount; r-- > 0;)
+	{
+		const Real* systemRow = mSystem.data() + r * width;
+		Real impulse = systemRow[unknownCount];
+		for (size_t c = r + 1; c < unknownCount; ++c)
+		{
+			impulse -= systemRow[c] * mSolution[mUnknowns[c]];
+		}
+		mSolution[mUnknowns[r]] = impulse / systemRow[r];
+	}
+	for (size_t k = 0; k < contactCount; ++k)
+	{
+		mSolution[2 * k + 1] +=
+			getSlidingSign(k) * mFrictions[k] * mSolution[2 * k];
+	}
+
+	mSolutionChanges.resize(rowCount);
+	for (size_t i = 0; i < rowCount; ++i)
+	{
+		mSolutionChanges[i] = mSolution[i] - (mImpulses[i] - mImpulseChanges[i]);
+	}
+	return true;
+}
+
+bool DirectSolver::updateContactStates(bool& isFailed)
+{
+	bool result = true;
+	const size_t contactCount = mRows.size() / 2;
+	for (size_t k = 0; k < contactCount; ++k)
+	{
+		const Real normalImpulse = mSolution[2 * k];
+		const Real tangentImpulse = mSolution[2 * k + 1];
+		const Real normalVelocity = getVelocity(2 * k, mSolutionChanges);
+		const Real tangentVelocity = getVelocity(2 * k + 1, mSolutionChanges);
+		const Real maxFriction = mFrictions[k] * normalImpulse;
+
+		ContactState& state = mContactStates[k];
+		if (state == ContactState::SEPARATED)
+		{
+			// An approaching contact must push
+			if (normalVelocity < -VELOCITY_TOLERANCE)
+			{
+				state = ContactState::STICKING;
+				result = false;
+			}
+			continue;
+		}
+
+		// The velocities of the unknowns vanish up to the precision
+		if (abs(normalVelocity) > VELOCITY_TOLERANCE ||
+			(state == ContactState::STICKING &&
+				abs(tangentVelocity) > VELOCITY_TOLERANCE))
+		{
+			isFailed = true;
+			return false;
+		}
+
+		if (normalImpulse < 0.0f)
+		{
+			// A pulling contact must separate
+			state = ContactState::SEPARATED;
+			result = false;
+		}
+		else if (state == ContactState::STICKING &&
+			abs(tangentImpulse) > maxFriction * (1.0f + FRICTION_TOLERANCE))
+		{
+			// The friction beyond the bound must slide
+			state = tangentImpulse > 0.0f ?
+				ContactState::SLIDING_POSITIVE :
+				ContactState::SLIDING_NEGATIVE;
+			result = false;
+		}
+		else if (mFrictions[k] > 0.0f &&
+			getSlidingSign(k) * tangentVelocity > VELOCITY_TOLERANCE)
+		{
+			// The sliding friction must oppose the sliding
+			state = ContactState::STICKING;
+			result = false;
+		}
+	}
+	return result;
+}
+
+uint32_t DirectSolver::solve(std::span<ContactManifold* const> manifolds)
+{
+	mBodies.clear();
+	mRows.clear();
+	mVelocities.clear();
+	mImpulses.clear();
+	mFrictions.clear();
+
+	// The normal and the friction constraint of each contact
+	for (const ContactManifold* manifold : manifolds)
+	{
+		const Body& bodyA = manifold->getBodyA();
+		const Body& bodyB = manifold->getBodyB();
+		const std::array<uint32_t, 2> bodies{ addBody(bodyA), addBody(bodyB) };
+		for (uint32_t ci = 0; ci < manifold->getContactCount(); ++ci)
+		{
+			const ContactPoint& contact = manifold->getContact(ci);
+			const Vec2 velocity =
+				bodyB.linearVelocity + cross(bodyB.angularVelocity, contact.getOffsetB()) -
+				bodyA.linearVelocity - cross(bodyA.angularVelocity, contact.getOffsetA());
+
+			const Vec2& normal = contact.getNormal();
+			for (const Vec2& direction : { normal, cross(normal, 1.0f) })
+			{
+				mRows.push_back({
+					bodies,
+					{ -direction, direction },
+					{
+						-cross(contact.getOffsetA(), direction),
+						cross(contact.getOffsetB(), direction) } });
+				mVelocities.push_back(dot(velocity, direction));
+			}
+			// The speculative contacts may approach by the gap
+			mVelocities[mVelocities.size() - 2] += contact.getGapVelocity();
+
+			mImpulses.push_back(contact.getNormalImpulse());
+			mImpulses.push_back(contact.getTangentImpulse());
+			mFrictions.push_back(manifold->getFriction());
+		}
+	}
+
+	// The matrix is symmetric
+	const size_t rowCount = mRows.size();
+	mMatrix.resize(rowCount * rowCount);
+	for (size_t i = 0; i < rowCount; ++i)
+	{
+		for (size_t j = i; j < rowCount; ++j)
+		{
+			const Real element = getMatrixElement(mRows[i], mRows[j]);
+			mMatrix[i * rowCount + j] = element;
+			mMatrix[j * rowCount + i] = element;
+		}
+	}
+
+	mImpulseChanges.assign(rowCount, 0.0f);
+	uint32_t iterationCount = 0;
+	while (iterationCount < MAX_ITERATIONS &&
+		!iterate(ACTIVE_SET_ITERATIONS, iterationCount) &&
+		!solveActiveSet())
+	{
+	}
+
+	// Apply the impulses in the order of the constraints
+	size_t row = 0;
+	for (ContactManifold* manifold : manifolds)
+	{
+		for (uint32_t ci = 0; ci < manifold->getContactCount(); ++ci)
+		{
+			manifold->setContactImpulses(ci, mImpulses[row], mImpulses[row + 1]);
+			row += 2;
+		}
+	}
+	return iterationCount;
+}
+
+} // namespace nph
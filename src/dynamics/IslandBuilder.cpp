@@ -0,0 +1,87 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "neat_physics/dynamics/IslandBuilder.h"
+#include <numeric>
+
+namespace nph
+{
+
+namespace
+{
+
+/// Marks a body without an island
+constexpr uint32_t NO_ISLAND = std::numeric_limits<uint32_t>::max();
+
+} // anonymous namespace
+
+void IslandBuilder::build(
+	const BodyArray& bodies,
+	std::span<const std::pair<uint32_t, uint32_t>> bodyPairs)
+{
+	const uint32_t bodyCount = static_cast<uint32_t>(bodies.size());
+	mParents.resize(bodyCount);
+	std::iota(mParents.begin(), mParents.end(), 0);
+
+	// Join the dynamic bodies in contact
+	for (const auto& [bodyIndA, bodyIndB] : bodyPairs)
+	{
+		if (bodies[bodyIndA].isStatic() || bodies[bodyIndB].isStatic())
+		{
+			continue;
+		}
+
+		const uint32_t rootA = findRoot(bodyIndA);
+		const uint32_t rootB = findRoot(bodyIndB);
+		if (rootA != rootB)
+		{
+			// The smaller index is the root, so the islands
+			// do not depend on the manifold order
+			mParents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+		}
+	}
+
+	// Number the islands in the order of their first manifolds
+	// and count their manifolds
+	mRootIslands.assign(bodyCount, NO_ISLAND);
+	mIslandStarts.assign(1, 0);
+	mManifoldIslands.resize(bodyPairs.size());
+	for (uint32_t mi = 0; mi < bodyPairs.size(); ++mi)
+	{
+		const auto& [bodyIndA, bodyIndB] = bodyPairs[mi];
+		assert(!bodies[bodyIndA].isStatic() || !bodies[bodyIndB].isStatic());
+		const uint32_t root = findRoot(
+			bodies[bodyIndA].isStatic() ? bodyIndB : bodyIndA);
+
+		if (mRootIslands[root] == NO_ISLAND)
+		{
+			mRootIslands[root] = static_cast<uint32_t>(mIslandStarts.size() - 1);
+			mIslandStarts.push_back(0);
+		}
+		mManifoldIslands[mi] = mRootIslands[root];
+		++mIslandStarts[mRootIslands[root] + 1];
+	}
+
+	// Counting sort of the manifolds by the islands
+	std::partial_sum(mIslandStarts.begin(), mIslandStarts.end(), mIslandStarts.begin());
+	mIslandEnds.assign(mIslandStarts.begin(), mIslandStarts.end() - 1);
+	mManifoldIndices.resize(bodyPairs.size());
+	for (uint32_t mi = 0; mi < bodyPairs.size(); ++mi)
+	{
+		mManifoldIndices[mIslandEnds[mManifoldIslands[mi]]++] = mi;
+	}
+}
+
+uint32_t IslandBuilder::findRoot(uint32_t bodyIndex) noexcept
+{
+	while (mParents[bodyIndex] != bodyIndex)
+	{
+		mParents[bodyIndex] = mParents[mParents[bodyIndex]];
+		bodyIndex = mParents[bodyIndex];
+	}
+	return bodyIndex;
+}
+
+} // namespace nph
@@ -0,0 +1,35 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// AVX2 kernels; the file must be compiled with the AVX2 flags (/arch:AVX2, -mavx2),
+// otherwise the kernels are not built.
+// The wide kernels require float lanes, so they are not built for the other scalar types.
+
+// Includes
+#include "KernelFpContract.h"
+#include "Kernels.h"
+
+#if NPH_SCALAR == NPH_SCALAR_FLOAT && defined(__AVX2__)
+#include "neat_physics/math/simd/FloatWAvx2.h"
+#include "WideKernels.h"
+#define NPH_KERNELS_BUILT 1
+#else
+#define NPH_KERNELS_BUILT 0
+#endif
+
+namespace nph
+{
+
+const KernelTable* getAvx2Kernels() noexcept
+{
+#if NPH_KERNELS_BUILT
+	static constexpr KernelTable TABLE =
+		WideKernels<simd::avx2::FloatW>::getTable(KernelIsa::AVX2);
+	return &TABLE;
+#else
+	return nullptr;
+#endif
+}
+
+} // namespace nph
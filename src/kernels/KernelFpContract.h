@@ -0,0 +1,20 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Disables the contraction of float expressions into FMA instructions
+// in the kernel source files, so the kernels of all instruction sets
+// produce the same results regardless of the toolchain defaults
+// (e.g. GCC contracts by default when FMA is enabled by -mfma or -mavx512f).
+// The pragmas are the ones of NPH_DETERMINISTIC (see Config.h); the header
+// must be included first, before any function of the file is defined.
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
@@ -0,0 +1,151 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "Kernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace nph
+{
+
+namespace
+{
+
+/// Instruction set extensions supported by the CPU and the OS
+struct CpuFeatures
+{
+	/// AVX2 support
+	bool avx2{ false };
+
+	/// AVX-512 foundation support
+	bool avx512{ false };
+};
+
+/// Detects the CPU features via CPUID
+[[nodiscard]] CpuFeatures detectCpuFeatures() noexcept
+{
+	CpuFeatures result;
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4];
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+
+	__cpuid(info, 1);
+	// The OS must save the AVX registers on context switches (OSXSAVE + XCR0)
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || maxLeaf < 7)
+	{
+		return result;
+	}
+
+	const unsigned long long xcr0 = _xgetbv(0);
+	// XMM and YMM state
+	const bool ymmEnabled = (xcr0 & 0x6) == 0x6;
+	// XMM, YMM, opmask and ZMM state
+	const bool zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+
+	__cpuidex(info, 7, 0);
+	result.avx2 = ymmEnabled && (info[1] & (1 << 5)) != 0;
+	result.avx512 = zmmEnabled && (info[1] & (1 << 16)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	// The builtins check the OS support as well
+	__builtin_cpu_init();
+	result.avx2 = __builtin_cpu_supports("avx2");
+	result.avx512 = __builtin_cpu_supports("avx512f");
+#endif
+	return result;
+}
+
+/// Returns the CPU features, detected once
+[[nodiscard]] const CpuFeatures& getCpuFeatures() noexcept
+{
+	static const CpuFeatures FEATURES = detectCpuFeatures();
+	return FEATURES;
+}
+
+/// Returns the kernels of an instruction set if they are built, otherwise nullptr
+[[nodiscard]] const KernelTable* findKernelTable(KernelIsa isa) noexcept
+{
+	switch (isa)
+	{
+	case KernelIsa::SCALAR:
+		return &getScalarKernels();
+	case KernelIsa::SSE2:
+		return getSse2Kernels();
+	case KernelIsa::AVX2:
+		return getAvx2Kernels();
+	case KernelIsa::AVX512:
+		return getAvx512Kernels();
+	case KernelIsa::NEON:
+		return getNeonKernels();
+	}
+	return nullptr;
+}
+
+} // anonymous namespace
+
+const char* getKernelIsaName(KernelIsa isa) noexcept
+{
+	switch (isa)
+	{
+	case KernelIsa::SCALAR:
+		return "scalar";
+	case KernelIsa::SSE2:
+		return "SSE2";
+	case KernelIsa::AVX2:
+		return "AVX2";
+	case KernelIsa::AVX512:
+		return "AVX-512";
+	case KernelIsa::NEON:
+		return "NEON";
+	}
+	return "unknown";
+}
+
+bool isKernelIsaSupported(KernelIsa isa) noexcept
+{
+	if (findKernelTable(isa) == nullptr)
+	{
+		return false;
+	}
+
+	// SSE2 and NEON are in the baselines of their platforms
+	const CpuFeatures& features = getCpuFeatures();
+	return
+		(isa != KernelIsa::AVX2 || features.avx2) &&
+		(isa != KernelIsa::AVX512 || features.avx512);
+}
+
+KernelIsa getBestKernelIsa() noexcept
+{
+	static const KernelIsa BEST = []
+	{
+		for (const KernelIsa isa : {
+			KernelIsa::AVX512,
+			KernelIsa::AVX2,
+			KernelIsa::SSE2,
+			KernelIsa::NEON })
+		{
+			if (isKernelIsaSupported(isa))
+			{
+				return isa;
+			}
+		}
+		return KernelIsa::SCALAR;
+	}();
+	return BEST;
+}
+
+const KernelTable& getKernelTable(KernelIsa isa) noexcept
+{
+	assert(isKernelIsaSupported(isa));
+	const KernelTable* table = findKernelTable(isa);
+	return table != nullptr ? *table : getScalarKernels();
+}
+
+} // namespace nph
@@ -0,0 +1,152 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include "neat_physics/Body.h"
+#include "neat_physics/KernelIsa.h"
+
+namespace nph
+{
+
+/// Active set of the sweep-and-prune in structure-of-arrays form:
+/// the Y extents and the static flags of the active AABBs
+struct ActiveSetView
+{
+	/// Minimum Y coordinates of the AABBs
+	const Real* minY;
+
+	/// Maximum Y coordinates of the AABBs
+	const Real* maxY;
+
+	/// 1 for static bodies, 0 for dynamic ones
+	const Real* isStatic;
+
+	/// Number of AABBs
+	uint32_t count;
+};
+
+/// Batch of box pairs for the separating axis test
+/// in structure-of-arrays form, one pair per index
+struct BoxPairBatch
+{
+	/// Maximum number of pairs in a batch
+	static constexpr uint32_t CAPACITY = 64;
+
+	/// Vector from the center of box A to the center of box B
+	alignas(64) Real centersX[CAPACITY];
+	alignas(64) Real centersY[CAPACITY];
+
+	/// Rotation matrix of box A, columns
+	alignas(64) Real rotationA11[CAPACITY];
+	alignas(64) Real rotationA21[CAPACITY];
+	alignas(64) Real rotationA12[CAPACITY];
+	alignas(64) Real rotationA22[CAPACITY];
+
+	/// Rotation matrix of box B, columns
+	alignas(64) Real rotationB11[CAPACITY];
+	alignas(64) Real rotationB21[CAPACITY];
+	alignas(64) Real rotationB12[CAPACITY];
+	alignas(64) Real rotationB22[CAPACITY];
+
+	/// Half sizes of box A
+	alignas(64) Real halfSizeAX[CAPACITY];
+	alignas(64) Real halfSizeAY[CAPACITY];
+
+	/// Half sizes of box B
+	alignas(64) Real halfSizeBX[CAPACITY];
+	alignas(64) Real halfSizeBY[CAPACITY];
+
+	/// Speculative distances: the pairs separated by less are kept
+	alignas(64) Real margins[CAPACITY];
+
+	/// Sets a pair
+	void set(
+		uint32_t index,
+		const Body& bodyA,
+		const Body& bodyB,
+		Real margin) noexcept
+	{
+		assert(index < CAPACITY);
+		const Mat22& rotationA = bodyA.rotation.getMat();
+		const Mat22& rotationB = bodyB.rotation.getMat();
+		const Vec2 centers = bodyB.position - bodyA.position;
+		centersX[index] = centers.x;
+		centersY[index] = centers.y;
+		rotationA11[index] = rotationA.col1.x;
+		rotationA21[index] = rotationA.col1.y;
+		rotationA12[index] = rotationA.col2.x;
+		rotationA22[index] = rotationA.col2.y;
+		rotationB11[index] = rotationB.col1.x;
+		rotationB21[index] = rotationB.col1.y;
+		rotationB12[index] = rotationB.col2.x;
+		rotationB22[index] = rotationB.col2.y;
+		halfSizeAX[index] = bodyA.halfSize.x;
+		halfSizeAY[index] = bodyA.halfSize.y;
+		halfSizeBX[index] = bodyB.halfSize.x;
+		halfSizeBY[index] = bodyB.halfSize.y;
+		margins[index] = margin;
+	}
+};
+
+/// Hot loops of the engine compiled for an instruction set, see KernelIsa
+/// The kernels do the same operations in the same order as the scalar ones,
+/// so all variants produce the same bits.
+struct KernelTable
+{
+	/// Instruction set
+	KernelIsa isa;
+
+	/// Applies the gravity to the dynamic bodies, see World::applyForces
+	void (*applyForces)(
+		Body* bodies,
+		uint32_t count,
+		Real timeStep,
+		const Vec2& gravity) noexcept;
+
+	/// Integrates the positions of the bodies, but not the rotations:
+	/// they require sine and cosine, see World::integratePositions
+	void (*integratePositions)(
+		Body* bodies,
+		uint32_t count,
+		Real timeStep) noexcept;
+
+	/// Finds the active AABBs overlapping an AABB along the Y axis;
+	/// for a static body the static AABBs are skipped
+	/// \param slots Receives the indices of the overlapping AABBs
+	/// in the active set in the ascending order; must have set.count elements
+	/// \return the number of the overlapping AABBs
+	uint32_t (*findActiveOverlaps)(
+		const ActiveSetView& set,
+		Real minY,
+		Real maxY,
+		bool isStatic,
+		uint32_t* slots) noexcept;
+
+	/// Separating axis test of a batch of box pairs,
+	/// equal to the first step of getBoxBoxCollision;
+	/// nullptr if the pairs are not tested before the narrow phase
+	/// \return the bit mask of the pairs with no axis separating them
+	/// by more than the margin
+	uint64_t (*findOverlappingBoxPairs)(
+		const BoxPairBatch& batch,
+		uint32_t count) noexcept;
+};
+
+/// Returns the kernels of an instruction set;
+/// asserts that the instruction set is supported
+[[nodiscard]] const KernelTable& getKernelTable(KernelIsa isa) noexcept;
+
+/// Returns the scalar kernels
+[[nodiscard]] const KernelTable& getScalarKernels() noexcept;
+
+/// Returns the kernels of an instruction set
+/// or nullptr if they are not built (see the kernel source files)
+[[nodiscard]] const KernelTable* getSse2Kernels() noexcept;
+[[nodiscard]] const KernelTable* getAvx2Kernels() noexcept;
+[[nodiscard]] const KernelTable* getAvx512Kernels() noexcept;
+[[nodiscard]] const KernelTable* getNeonKernels() noexcept;
+
+} // namespace nph
@@ -0,0 +1,34 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// NEON kernels, part of the AArch64 baseline, so no special compiler flags are needed.
+// The wide kernels require float lanes, so they are not built for the other scalar types.
+
+// Includes
+#include "KernelFpContract.h"
+#include "Kernels.h"
+
+#if NPH_SCALAR == NPH_SCALAR_FLOAT && (defined(__aarch64__) || defined(_M_ARM64))
+#include "neat_physics/math/simd/FloatWNeon.h"
+#include "WideKernels.h"
+#define NPH_KERNELS_BUILT 1
+#else
+#define NPH_KERNELS_BUILT 0
+#endif
+
+namespace nph
+{
+
+const KernelTable* getNeonKernels() noexcept
+{
+#if NPH_KERNELS_BUILT
+	static constexpr KernelTable TABLE =
+		WideKernels<simd::neon::FloatW>::getTable(KernelIsa::NEON);
+	return &TABLE;
+#else
+	return nullptr;
+#endif
+}
+
+} // namespace nph
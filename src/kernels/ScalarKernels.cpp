@@ -0,0 +1,81 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "KernelFpContract.h"
+#include "Kernels.h"
+
+namespace nph
+{
+
+namespace
+{
+
+void applyForces(
+	Body* bodies,
+	uint32_t count,
+	Real timeStep,
+	const Vec2& gravity) noexcept
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		Body& body = bodies[i];
+		body.linearVelocity += (!body.isStatic()) * timeStep * gravity;
+	}
+}
+
+void integratePositions(
+	Body* bodies,
+	uint32_t count,
+	Real timeStep) noexcept
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		Body& body = bodies[i];
+		body.position += timeStep * body.linearVelocity;
+	}
+}
+
+uint32_t findActiveOverlaps(
+	const ActiveSetView& set,
+	Real minY,
+	Real maxY,
+	bool isStatic,
+	uint32_t* slots) noexcept
+{
+	uint32_t slotCount = 0;
+	for (uint32_t i = 0; i < set.count; ++i)
+	{
+		if (isStatic && set.isStatic[i] != 0.0f)
+		{
+			continue;
+		}
+
+		// If y-axes don't intersect
+		if (maxY < set.minY[i] ||
+			set.maxY[i] < minY)
+		{
+			continue;
+		}
+		slots[slotCount++] = i;
+	}
+	return slotCount;
+}
+
+} // anonymous namespace
+
+const KernelTable& getScalarKernels() noexcept
+{
+	// The pairs are not tested before the narrow phase,
+	// since it starts with the same test
+	static constexpr KernelTable TABLE{
+		KernelIsa::SCALAR,
+		&applyForces,
+		&integratePositions,
+		&findActiveOverlaps,
+		nullptr };
+	return TABLE;
+}
+
+} // namespace nph
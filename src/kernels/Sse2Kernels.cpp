@@ -0,0 +1,34 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// SSE2 kernels, part of the x64 baseline, so no special compiler flags are needed.
+// The wide kernels require float lanes, so they are not built for the other scalar types.
+
+// Includes
+#include "KernelFpContract.h"
+#include "Kernels.h"
+
+#if NPH_SCALAR == NPH_SCALAR_FLOAT && (defined(_M_X64) || defined(__SSE2__))
+#include "neat_physics/math/simd/FloatWSse2.h"
+#include "WideKernels.h"
+#define NPH_KERNELS_BUILT 1
+#else
+#define NPH_KERNELS_BUILT 0
+#endif
+
+namespace nph
+{
+
+const KernelTable* getSse2Kernels() noexcept
+{
+#if NPH_KERNELS_BUILT
+	static constexpr KernelTable TABLE =
+		WideKernels<simd::sse2::FloatW>::getTable(KernelIsa::SSE2);
+	return &TABLE;
+#else
+	return nullptr;
+#endif
+}
+
+} // namespace nph
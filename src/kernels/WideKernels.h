@@ -0,0 +1,231 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Includes
+#include "Kernels.h"
+
+namespace nph
+{
+
+/// Kernels built on the wide types, instantiated per instruction set
+/// in the kernel source files compiled with the instruction set flags.
+/// \note For this reason the kernels must not call non-template inline
+/// functions of the engine or the standard library (e.g. Vec2 operators):
+/// the linker may keep the copy compiled with the wider instruction set
+/// for the whole program. Only the data members of the engine types and
+/// the wide types, which have a namespace per instruction set, are used.
+template <typename FloatW>
+struct WideKernels
+{
+	/// Number of lanes
+	static constexpr uint32_t W = FloatW::WIDTH;
+
+	/// \see KernelTable::applyForces
+	static void applyForces(
+		Body* bodies,
+		uint32_t count,
+		Real timeStep,
+		const Vec2& gravity) noexcept
+	{
+		const FloatW step(timeStep);
+		const FloatW gravityX(gravity.x);
+		const FloatW gravityY(gravity.y);
+		alignas(64) float lanes[3][W];
+
+		uint32_t i = 0;
+		for (; i + W <= count; i += W)
+		{
+			for (uint32_t l = 0; l < W; ++l)
+			{
+				const Body& body = bodies[i + l];
+				lanes[0][l] = body.mass;
+				lanes[1][l] = body.linearVelocity.x;
+				lanes[2][l] = body.linearVelocity.y;
+			}
+
+			// (!isStatic()) * timeStep * gravity
+			const FloatW factor = select(
+				FloatW::load(lanes[0]) == FloatW(0.0f),
+				FloatW(0.0f),
+				FloatW(1.0f)) * step;
+			(FloatW::load(lanes[1]) + factor * gravityX).store(lanes[1]);
+			(FloatW::load(lanes[2]) + factor * gravityY).store(lanes[2]);
+
+			for (uint32_t l = 0; l < W; ++l)
+			{
+				Body& body = bodies[i + l];
+				body.linearVelocity.x = lanes[1][l];
+				body.linearVelocity.y = lanes[2][l];
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			Body& body = bodies[i];
+			const Real factor = (body.mass == 0.0f ? 0.0f : 1.0f) * timeStep;
+			body.linearVelocity.x += factor * gravity.x;
+			body.linearVelocity.y += factor * gravity.y;
+		}
+	}
+
+	/// \see KernelTable::integratePositions
+	static void integratePositions(
+		Body* bodies,
+		uint32_t count,
+		Real timeStep) noexcept
+	{
+		const FloatW step(timeStep);
+		alignas(64) float lanes[4][W];
+
+		uint32_t i = 0;
+		for (; i + W <= count; i += W)
+		{
+			for (uint32_t l = 0; l < W; ++l)
+			{
+				const Body& body = bodies[i + l];
+				lanes[0][l] = body.position.x;
+				lanes[1][l] = body.position.y;
+				lanes[2][l] = body.linearVelocity.x;
+				lanes[3][l] = body.linearVelocity.y;
+			}
+
+			(FloatW::load(lanes[0]) + step * FloatW::load(lanes[2])).store(lanes[0]);
+			(FloatW::load(lanes[1]) + step * FloatW::load(lanes[3])).store(lanes[1]);
+
+			for (uint32_t l = 0; l < W; ++l)
+			{
+				Body& body = bodies[i + l];
+				body.position.x = lanes[0][l];
+				body.position.y = lanes[1][l];
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			Body& body = bodies[i];
+			body.position.x += timeStep * body.linearVelocity.x;
+			body.position.y += timeStep * body.linearVelocity.y;
+		}
+	}
+
+	/// \see KernelTable::findActiveOverlaps
+	static uint32_t findActiveOverlaps(
+		const ActiveSetView& set,
+		Real minY,
+		Real maxY,
+		bool isStatic,
+		uint32_t* slots) noexcept
+	{
+		const FloatW queryMinY(minY);
+		const FloatW queryMaxY(maxY);
+		const FloatW zero(0.0f);
+
+		uint32_t slotCount = 0;
+		uint32_t i = 0;
+		for (; i + W <= set.count; i += W)
+		{
+			// The negated comparisons of the scalar kernel, which keep NaN overlapping
+			typename FloatW::Mask separated =
+				(queryMaxY < FloatW::load(set.minY + i)) |
+				(FloatW::load(set.maxY + i) < queryMinY);
+			if (isStatic)
+			{
+				separated = separated | (FloatW::load(set.isStatic + i) != zero);
+			}
+
+			// Branchless compaction of the overlapping lanes
+			const uint32_t bits = (~separated).getBits();
+			for (uint32_t l = 0; l < W; ++l)
+			{
+				slots[slotCount] = i + l;
+				slotCount += (bits >> l) & 1u;
+			}
+		}
+
+		for (; i < set.count; ++i)
+		{
+			if ((isStatic && set.isStatic[i] != 0.0f) ||
+				maxY < set.minY[i] ||
+				set.maxY[i] < minY)
+			{
+				continue;
+			}
+			slots[slotCount++] = i;
+		}
+		return slotCount;
+	}
+
+	/// \see KernelTable::findOverlappingBoxPairs
+	/// The operations repeat the ones of getBoxBoxCollision
+	static uint64_t findOverlappingBoxPairs(
+		const BoxPairBatch& batch,
+		uint32_t count) noexcept
+	{
+		static_assert(BoxPairBatch::CAPACITY % W == 0);
+		assert(count <= BoxPairBatch::CAPACITY);
+
+		uint64_t result = 0;
+		for (uint32_t i = 0; i < count; i += W)
+		{
+			const FloatW dx = FloatW::load(batch.centersX + i);
+			const FloatW dy = FloatW::load(batch.centersY + i);
+			const FloatW a11 = FloatW::load(batch.rotationA11 + i);
+			const FloatW a21 = FloatW::load(batch.rotationA21 + i);
+			const FloatW a12 = FloatW::load(batch.rotationA12 + i);
+			const FloatW a22 = FloatW::load(batch.rotationA22 + i);
+			const FloatW b11 = FloatW::load(batch.rotationB11 + i);
+			const FloatW b21 = FloatW::load(batch.rotationB21 + i);
+			const FloatW b12 = FloatW::load(batch.rotationB12 + i);
+			const FloatW b22 = FloatW::load(batch.rotationB22 + i);
+			const FloatW hax = FloatW::load(batch.halfSizeAX + i);
+			const FloatW hay = FloatW::load(batch.halfSizeAY + i);
+			const FloatW hbx = FloatW::load(batch.halfSizeBX + i);
+			const FloatW hby = FloatW::load(batch.halfSizeBY + i);
+			const FloatW minPenetration = -FloatW::load(batch.margins + i);
+
+			// A -> B relative rotation, transpose(A) * B, absolute values
+			const FloatW r11 = abs(a11 * b11 + a21 * b21);
+			const FloatW r21 = abs(a12 * b11 + a22 * b21);
+			const FloatW r12 = abs(a11 * b12 + a21 * b22);
+			const FloatW r22 = abs(a12 * b12 + a22 * b22);
+
+			// Axes of box A
+			const FloatW penetrationAX = hax -
+				(abs(a11 * dx + a21 * dy) - (r11 * hbx + r21 * hby));
+			const FloatW penetrationAY = hay -
+				(abs(a12 * dx + a22 * dy) - (r12 * hbx + r22 * hby));
+
+			// Axes of box B
+			const FloatW penetrationBX = hbx -
+				(abs(b11 * dx + b21 * dy) - (r11 * hax + r12 * hay));
+			const FloatW penetrationBY = hby -
+				(abs(b12 * dx + b22 * dy) - (r21 * hax + r22 * hay));
+
+			const typename FloatW::Mask separated =
+				(penetrationAX < minPenetration) |
+				(penetrationAY < minPenetration) |
+				(penetrationBX < minPenetration) |
+				(penetrationBY < minPenetration);
+			result |= static_cast<uint64_t>((~separated).getBits()) << i;
+		}
+
+		// The lanes >= count contain arbitrary data
+		return count == 64 ? result : result & ((uint64_t(1) << count) - 1);
+	}
+
+	/// Table of the kernels
+	static constexpr KernelTable getTable(KernelIsa isa) noexcept
+	{
+		return {
+			isa,
+			&applyForces,
+			&integratePositions,
+			&findActiveOverlaps,
+			&findOverlappingBoxPairs };
+	}
+};
+
+} // namespace nph
@@ -0,0 +1,204 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include "neat_physics/math/MathFunctions.h"
+#include <limits>
+
+namespace nph
+{
+
+namespace
+{
+
+#if NPH_SCALAR == NPH_SCALAR_FLOAT
+
+// The range reduction and the polynomials are taken from
+// the FreeBSD float implementation (e_rem_pio2f.c, k_sinf.c, k_cosf.c)
+
+/// 2 / pi
+constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+
+/// First 33 bits of pi / 2, so that k * PI_OVER_2_HIGH is exact for |k| < 2^20
+constexpr double PI_OVER_2_HIGH = 1.57079631090164184570e+00;
+
+/// pi / 2 - PI_OVER_2_HIGH
+constexpr double PI_OVER_2_LOW = 1.58932547735281966916e-08;
+
+/// Sine polynomial coefficients, |sin(x) / x - s(x)| < 2^-37.5 for |x| <= pi / 4
+constexpr double S1 = -0x15555554cbac77.0p-55;
+constexpr double S2 = 0x111110896efbb2.0p-59;
+constexpr double S3 = -0x1a00f9e2cae774.0p-65;
+constexpr double S4 = 0x16cd878c3b46a7.0p-71;
+
+/// Cosine polynomial coefficients, |cos(x) - c(x)| < 2^-34.1 for |x| <= pi / 4
+constexpr double C0 = -0x1ffffffd0c5e81.0p-54;
+constexpr double C1 = 0x155553e1053a42.0p-57;
+constexpr double C2 = -0x16c087e80f1e27.0p-62;
+constexpr double C3 = 0x199342e0ee5069.0p-68;
+
+/// Sine for |x| <= pi / 4
+[[nodiscard]] double sinKernel(double x) noexcept
+{
+	const double z = x * x;
+	const double w = z * z;
+	const double r = S3 + z * S4;
+	const double s = z * x;
+	return (x + s * (S1 + z * S2)) + s * w * r;
+}
+
+/// Cosine for |x| <= pi / 4
+[[nodiscard]] double cosKernel(double x) noexcept
+{
+	const double z = x * x;
+	const double w = z * z;
+	const double r = C2 + z * C3;
+	return ((1.0 + z * C0) + w * C1) + (w * z) * r;
+}
+
+#elif NPH_SCALAR == NPH_SCALAR_DOUBLE
+
+// The range reduction and the polynomials are taken from
+// the FreeBSD double implementation (e_rem_pio2.c, k_sin.c, k_cos.c)
+
+/// 2 / pi
+constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+
+/// pi / 2 split into 33-bit parts, so that k * part is exact for |k| < 2^20,
+/// each part is followed by the remainder of pi / 2
+constexpr double PI_OVER_2_1 = 1.57079632673412561417e+00;
+constexpr double PI_OVER_2_1_TAIL = 6.07710050650619224932e-11;
+constexpr double PI_OVER_2_2 = 6.07710050630396597660e-11;
+constexpr double PI_OVER_2_2_TAIL = 2.02226624879595063154e-21;
+constexpr double PI_OVER_2_3 = 2.02226624871116645580e-21;
+constexpr double PI_OVER_2_3_TAIL = 8.47842766036889956997e-32;
+
+/// Sine polynomial coefficients, |sin(x) / x - s(x)| < 2^-58 for |x| <= pi / 4
+constexpr double S1 = -1.66666666666666324348e-01;
+constexpr double S2 = 8.33333333332248946124e-03;
+constexpr double S3 = -1.98412698298579493134e-04;
+constexpr double S4 = 2.75573137070700676789e-06;
+constexpr double S5 = -2.50507602534068634195e-08;
+constexpr double S6 = 1.58969099521155010221e-10;
+
+/// Cosine polynomial coefficients, |cos(x) - c(x)| < 2^-58 for |x| <= pi / 4
+constexpr double C1 = 4.16666666666666019037e-02;
+constexpr double C2 = -1.38888888888741095749e-03;
+constexpr double C3 = 2.48015872894767294178e-05;
+constexpr double C4 = -2.75573143513906633035e-07;
+constexpr double C5 = 2.08757232129817482790e-09;
+constexpr double C6 = -1.13596475577881948265e-11;
+
+/// Sine of x + y for |x + y| <= pi / 4, y is the tail of x
+[[nodiscard]] double sinKernel(double x, double y) noexcept
+{
+	const double z = x * x;
+	const double w = z * z;
+	const double r = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+	const double v = z * x;
+	return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+}
+
+/// Cosine of x + y for |x + y| <= pi / 4, y is the tail of x
+[[nodiscard]] double cosKernel(double x, double y) noexcept
+{
+	const double z = x * x;
+	const double w = z * z;
+	const double r = z * (C1 + z * (C2 + z * C3)) + w * w * (C4 + z * (C5 + z * C6));
+	const double halfZ = 0.5 * z;
+	const double oneMinusHalfZ = 1.0 - halfZ;
+	return oneMinusHalfZ + (((1.0 - oneMinusHalfZ) - halfZ) + (z * r - x * y));
+}
+
+#endif
+
+} // anonymous namespace
+
+#if NPH_SCALAR == NPH_SCALAR_FLOAT
+
+SinCos portableSinCos(float angleRad) noexcept
+{
+	if (!std::isfinite(angleRad))
+	{
+		constexpr float NAN_VALUE = std::numeric_limits<float>::quiet_NaN();
+		return { NAN_VALUE, NAN_VALUE };
+	}
+
+	// Reduce the angle to [-pi / 4, pi / 4] and the quadrant
+	const double x = angleRad;
+	const double k = std::floor(x * TWO_OVER_PI + 0.5);
+	const double r = (x - k * PI_OVER_2_HIGH) - k * PI_OVER_2_LOW;
+	const int quadrant = (static_cast<int>(std::fmod(k, 4.0)) + 4) & 3;
+
+	const float s = static_cast<float>(sinKernel(r));
+	const float c = static_cast<float>(cosKernel(r));
+	switch (quadrant)
+	{
+	case 0:
+		return { s, c };
+	case 1:
+		return { c, -s };
+	case 2:
+		return { -s, -c };
+	default:
+		return { -c, s };
+	}
+}
+
+#elif NPH_SCALAR == NPH_SCALAR_DOUBLE
+
+SinCos portableSinCos(double angleRad) noexcept
+{
+	if (!std::isfinite(angleRad))
+	{
+		constexpr double NAN_VALUE = std::numeric_limits<double>::quiet_NaN();
+		return { NAN_VALUE, NAN_VALUE };
+	}
+
+	// Reduce the angle to [-pi / 4, pi / 4] and the quadrant;
+	// the result is the sum of the head and the tail. The next parts of pi / 2
+	// are used only if the previous ones cancel too many bits of the angle
+	const double x = angleRad;
+	const double k = std::floor(x * TWO_OVER_PI + 0.5);
+	double r = x - k * PI_OVER_2_1;
+	double tail = k * PI_OVER_2_1_TAIL;
+	double head = r - tail;
+	const int exponent = std::ilogb(x);
+	if (exponent - std::ilogb(head) > 16)
+	{
+		double previous = r;
+		double correction = k * PI_OVER_2_2;
+		r = previous - correction;
+		tail = k * PI_OVER_2_2_TAIL - ((previous - r) - correction);
+		head = r - tail;
+		if (exponent - std::ilogb(head) > 49)
+		{
+			previous = r;
+			correction = k * PI_OVER_2_3;
+			r = previous - correction;
+			tail = k * PI_OVER_2_3_TAIL - ((previous - r) - correction);
+			head = r - tail;
+		}
+	}
+	tail = (r - head) - tail;
+	const int quadrant = (static_cast<int>(std::fmod(k, 4.0)) + 4) & 3;
+
+	const double s = sinKernel(head, tail);
+	const double c = cosKernel(head, tail);
+	switch (quadrant)
+	{
+	case 0:
+		return { s, c };
+	case 1:
+		return { c, -s };
+	case 2:
+		return { -s, -c };
+	default:
+		return { -c, s };
+	}
+}
+
+#endif
+
+} // namespace nph
@@ -0,0 +1,871 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <optional>
+#include <random>
+#include "neat_physics/StateEncoder.h"
+#include "neat_physics/World.h"
+#include "Core.h"
+#include "Trajectory.h"
+
+using namespace nph;
+
+namespace
+{
+
+/// Simulation parameters shared by the benchmarks
+constexpr float TIME_STEP = 1.0f / 60.0f;
+constexpr uint32_t SOLVER_VELOCITY_ITERATIONS = 15;
+constexpr uint32_t SOLVER_POSITION_ITERATIONS = 5;
+constexpr Vec2 GRAVITY = Vec2(0.0f, -10.0f);
+
+/// Number of bodies the results are normalized to
+constexpr double BODIES_PER_RESULT = 10000.0;
+
+/// Clock used for the measurements
+using Clock = std::chrono::steady_clock;
+
+/// Returns the elapsed time since start in microseconds
+double getElapsedMicroseconds(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::micro>(
+		Clock::now() - start).count();
+}
+
+/// Creates a pile of columnCount x rowCount boxes on a static ground
+void createPileScene(World& world, int columnCount, int rowCount)
+{
+	constexpr float BOX_SIZE = 1.0f;
+	constexpr float FRICTION = 0.5f;
+	constexpr float GROUND_THICKNESS = 5.0f;
+
+	const float width = static_cast<float>(columnCount) * BOX_SIZE;
+	world.addBody(
+		{ width + 2.0f * GROUND_THICKNESS, GROUND_THICKNESS },
+		0.0f,
+		FRICTION,
+		{ 0.0f, -GROUND_THICKNESS * 0.5f });
+
+	for (int row = 0; row < rowCount; ++row)
+	{
+		for (int col = 0; col < columnCount; ++col)
+		{
+			// Shift odd rows to get a brick-like pile
+			const float shift = (row % 2 == 0) ? 0.0f : 0.25f * BOX_SIZE;
+			world.addBody(
+				{ BOX_SIZE, BOX_SIZE },
+				BOX_SIZE * BOX_SIZE,
+				FRICTION,
+				{
+					-0.5f * width + (static_cast<float>(col) + 0.5f) * BOX_SIZE + shift,
+					(static_cast<float>(row) + 0.5f) * BOX_SIZE * 1.01f
+				});
+		}
+	}
+}
+
+/// Creates stackCount separate stacks of stackHeight boxes on a static ground;
+/// the odd boxes of a stack are massRatio times heavier
+void createStacksScene(World& world, int stackCount, int stackHeight, float massRatio)
+{
+	constexpr float BOX_SIZE = 1.0f;
+	constexpr float GAP = 3.0f;
+	constexpr float FRICTION = 0.5f;
+	constexpr float GROUND_THICKNESS = 5.0f;
+
+	const float width = static_cast<float>(stackCount) * (BOX_SIZE + GAP);
+	world.addBody(
+		{ width + 2.0f * GROUND_THICKNESS, GROUND_THICKNESS },
+		0.0f,
+		FRICTION,
+		{ 0.0f, -GROUND_THICKNESS * 0.5f });
+
+	for (int stack = 0; stack < stackCount; ++stack)
+	{
+		for (int row = 0; row < stackHeight; ++row)
+		{
+			// Shift the boxes slightly to get unsymmetric contacts
+			world.addBody(
+				{ BOX_SIZE, BOX_SIZE },
+				(row % 2 == 0 ? 1.0f : massRatio) * BOX_SIZE * BOX_SIZE,
+				FRICTION,
+				{
+					-0.5f * width + static_cast<float>(stack) * (BOX_SIZE + GAP) +
+						0.1f * static_cast<float>(row),
+					(static_cast<float>(row) + 0.5f) * BOX_SIZE
+				});
+		}
+	}
+}
+
+/// Creates the scene of the regression test: a 'glass' with
+/// 20 x 100 randomized boxes
+void createRegressionScene(World& world)
+{
+	constexpr float BOTTOM_SIZE = 25.0f;
+	constexpr float BOTTOM_THICKNESS = 5.0f;
+	constexpr float BOX_BOTTOM_RATIO = 1.0f / 15.0f;
+	constexpr int COLUMN_COUNT = 20;
+	constexpr int ROW_COUNT = COLUMN_COUNT * 5;
+	constexpr float FRICTION = 0.5f;
+
+	// Bottom
+	world.addBody(
+		{ BOTTOM_SIZE + 2.0f * BOTTOM_THICKNESS, BOTTOM_THICKNESS },
+		0.0f,
+		FRICTION,
+		{ 0.0f, -BOTTOM_THICKNESS * 0.5f });
+
+	// Left side
+	world.addBody(
+		{ BOTTOM_THICKNESS, BOTTOM_SIZE * 2.0f },
+		0.0f,
+		FRICTION,
+		{ -(BOTTOM_SIZE + BOTTOM_THICKNESS) * 0.5f, BOTTOM_SIZE });
+
+	// Right side
+	world.addBody(
+		{ BOTTOM_THICKNESS, BOTTOM_SIZE * 2.0f },
+		0.0f,
+		FRICTION,
+		{ (BOTTOM_SIZE + BOTTOM_THICKNESS) * 0.5f, BOTTOM_SIZE });
+
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<> distrib(0.5, 1.0);
+
+	constexpr float BOX_SIZE = BOTTOM_SIZE * 0.5f * BOX_BOTTOM_RATIO;
+	const float startY = BOX_SIZE * 4.0f;
+	const float startX = -((COLUMN_COUNT - 1) * BOX_SIZE) / 2.0f;
+	for (int row = 0; row < ROW_COUNT; ++row)
+	{
+		for (int col = 0; col < COLUMN_COUNT; ++col)
+		{
+			// Separate statements fix the order of the random numbers
+			const float height = BOX_SIZE * static_cast<float>(distrib(gen));
+			const float width = BOX_SIZE * static_cast<float>(distrib(gen));
+			const float friction =
+				std::lerp(0.4f, 0.6f, static_cast<float>(distrib(gen)));
+
+			world.addBody(
+				{ width, height },
+				width * height * 1000.0f,
+				friction,
+				{ startX + col * BOX_SIZE, startY + row * BOX_SIZE });
+		}
+	}
+}
+
+/// Compile-time step configuration matching the runtime benchmark settings
+using BenchmarkStepConfig = StepConfig<
+	SOLVER_VELOCITY_ITERATIONS,
+	SOLVER_POSITION_ITERATIONS>;
+
+/// Measures the step time of the regression scene with the runtime
+/// and the compile-time step configurations
+void runStepConfigBenchmark()
+{
+	constexpr uint32_t BODIES_TO_RESERVE = 2048;
+	constexpr uint32_t MEASURED_STEPS = 400;
+
+	std::array<double, 2> stepTimes;
+	std::array<uint64_t, 2> stateHashes;
+	for (int specialized = 0; specialized < 2; ++specialized)
+	{
+		World world(
+			GRAVITY,
+			SOLVER_VELOCITY_ITERATIONS,
+			SOLVER_POSITION_ITERATIONS);
+
+		world.reserveBodies(BODIES_TO_RESERVE);
+		createRegressionScene(world);
+
+		const auto start = Clock::now();
+		for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+		{
+			if (specialized)
+			{
+				world.doStep<BenchmarkStepConfig>(TIME_STEP);
+			}
+			else
+			{
+				world.doStep(TIME_STEP);
+			}
+		}
+		stepTimes[specialized] = getElapsedMicroseconds(start) / MEASURED_STEPS;
+		stateHashes[specialized] = world.getStateHash();
+	}
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< "Step configuration, regression scene:"
+		<< " runtime " << stepTimes[0] << " us,"
+		<< " compile-time " << stepTimes[1] << " us,"
+		<< " results " << (stateHashes[0] == stateHashes[1] ? "identical" : "DIFFERENT")
+		<< "\n";
+}
+
+/// Measures the step time of the regression scene with the kernels
+/// of each supported instruction set, see World::setKernelIsa
+void runKernelIsaBenchmark()
+{
+	constexpr uint32_t BODIES_TO_RESERVE = 2048;
+	constexpr uint32_t MEASURED_STEPS = 400;
+
+	std::optional<uint64_t> scalarStateHash;
+	for (const KernelIsa isa : {
+		KernelIsa::SCALAR,
+		KernelIsa::SSE2,
+		KernelIsa::AVX2,
+		KernelIsa::AVX512,
+		KernelIsa::NEON })
+	{
+		World world(
+			GRAVITY,
+			SOLVER_VELOCITY_ITERATIONS,
+			SOLVER_POSITION_ITERATIONS);
+
+		if (!world.setKernelIsa(isa))
+		{
+			continue;
+		}
+
+		world.reserveBodies(BODIES_TO_RESERVE);
+		createRegressionScene(world);
+
+		const auto start = Clock::now();
+		for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+		{
+			world.doStep(TIME_STEP);
+		}
+		const double stepTime = getElapsedMicroseconds(start) / MEASURED_STEPS;
+		if (!scalarStateHash)
+		{
+			scalarStateHash = world.getStateHash();
+		}
+
+		std::cout << std::fixed << std::setprecision(1)
+			<< "Kernels, " << getKernelIsaName(isa)
+			<< (isa == getBestKernelIsa() ? " (selected)" : "") << ":"
+			<< " step " << stepTime << " us,"
+			<< " results " << (world.getStateHash() == *scalarStateHash ? "identical" : "DIFFERENT")
+			<< "\n";
+	}
+}
+
+/// Measures the step time of a settling pile with the scalar type
+/// the engine is built with (see NPH_SCALAR); run the benchmark variants
+/// to compare the scalar types
+void runStepBenchmark()
+{
+	constexpr int COLUMN_COUNT = 100;
+	constexpr int ROW_COUNT = 100;
+	constexpr uint32_t MEASURED_STEPS = 120;
+
+	World world(
+		GRAVITY,
+		SOLVER_VELOCITY_ITERATIONS,
+		SOLVER_POSITION_ITERATIONS);
+
+	world.reserveBodies(COLUMN_COUNT * ROW_COUNT + 1);
+	createPileScene(world, COLUMN_COUNT, ROW_COUNT);
+
+	const auto start = Clock::now();
+	for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+	{
+		world.doStep(TIME_STEP);
+	}
+	const double stepTime = getElapsedMicroseconds(start) / MEASURED_STEPS;
+
+	const double scale =
+		BODIES_PER_RESULT / static_cast<double>(world.getBodies().size());
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< "Step, " << REAL_TYPE_NAME << ":"
+		<< " step " << stepTime * scale << " us"
+		<< " (per 10k bodies)\n";
+}
+
+/// Compares the velocity solvers (see VelocitySolver) on a settling pile,
+/// on the regression scene and on stacks with a high mass ratio: the step
+/// time and the convergence, i.e. the mean of the maximum contact velocity
+/// error after the velocity iterations and the maximum penetration
+/// over the measured steps
+void runVelocitySolverBenchmark()
+{
+	constexpr int COLUMN_COUNT = 40;
+	constexpr int ROW_COUNT = 40;
+	constexpr int STACK_COUNT = 10;
+	constexpr int STACK_HEIGHT = 10;
+	constexpr float MASS_RATIO = 100.0f;
+	constexpr uint32_t BODIES_TO_RESERVE = 2048;
+	constexpr uint32_t MEASURED_STEPS = 240;
+
+	static constexpr const char* SCENE_NAMES[] = {
+		"pile",
+		"regression scene",
+		"mass ratio stacks" };
+
+	for (int scene = 0; scene < 3; ++scene)
+	{
+		for (const VelocitySolver solver : {
+			VelocitySolver::GAUSS_SEIDEL,
+			VelocitySolver::JACOBI })
+		{
+			World world(
+				GRAVITY,
+				SOLVER_VELOCITY_ITERATIONS,
+				SOLVER_POSITION_ITERATIONS);
+
+			world.setVelocitySolver(solver);
+			world.reserveBodies(BODIES_TO_RESERVE);
+			if (scene == 0)
+			{
+				createPileScene(world, COLUMN_COUNT, ROW_COUNT);
+			}
+			else if (scene == 1)
+			{
+				createRegressionScene(world);
+			}
+			else
+			{
+				createStacksScene(world, STACK_COUNT, STACK_HEIGHT, MASS_RATIO);
+			}
+
+			double stepTime = 0.0;
+			double velocityError = 0.0;
+			Real maxPenetration = 0.0f;
+			for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+			{
+				const auto start = Clock::now();
+				world.doStep(TIME_STEP);
+				stepTime += getElapsedMicroseconds(start);
+
+				const ContactSolver& contactSolver = world.getContactSolver();
+				velocityError += static_cast<double>(contactSolver.getMaxVelocityError());
+				maxPenetration = std::max(
+					maxPenetration,
+					contactSolver.getMaxPenetration());
+			}
+
+			static constexpr const char* SOLVER_NAMES[] = {
+				"Gauss-Seidel",
+				"Jacobi" };
+			std::cout << std::fixed << std::setprecision(1)
+				<< "Velocity solver, " << SCENE_NAMES[scene]
+				<< ", " << SOLVER_NAMES[static_cast<uint32_t>(solver)] << ":"
+				<< " step " << stepTime / MEASURED_STEPS << " us,"
+				<< std::setprecision(4)
+				<< " velocity error " << velocityError / MEASURED_STEPS << ","
+				<< " max penetration " << static_cast<double>(maxPenetration)
+				<< "\n";
+		}
+	}
+}
+
+/// Compares the position solvers (see PositionSolver) on a settling pile
+/// and on the regression scene: the step time, the mean and the maximum
+/// of the maximum penetration over the measured steps
+void runPositionSolverBenchmark()
+{
+	constexpr int COLUMN_COUNT = 40;
+	constexpr int ROW_COUNT = 40;
+	constexpr uint32_t BODIES_TO_RESERVE = 2048;
+	constexpr uint32_t MEASURED_STEPS = 240;
+
+	for (int scene = 0; scene < 2; ++scene)
+	{
+		for (const PositionSolver solver : {
+			PositionSolver::PBD,
+			PositionSolver::PSEUDO_VELOCITIES })
+		{
+			World world(
+				GRAVITY,
+				SOLVER_VELOCITY_ITERATIONS,
+				SOLVER_POSITION_ITERATIONS);
+
+			world.setPositionSolver(solver);
+			world.reserveBodies(BODIES_TO_RESERVE);
+			if (scene == 0)
+			{
+				createPileScene(world, COLUMN_COUNT, ROW_COUNT);
+			}
+			else
+			{
+				createRegressionScene(world);
+			}
+
+			double stepTime = 0.0;
+			double meanPenetration = 0.0;
+			Real maxPenetration = 0.0f;
+			for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+			{
+				const auto start = Clock::now();
+				world.doStep(TIME_STEP);
+				stepTime += getElapsedMicroseconds(start);
+
+				const Real penetration = world.getContactSolver().getMaxPenetration();
+				meanPenetration += static_cast<double>(penetration);
+				maxPenetration = std::max(maxPenetration, penetration);
+			}
+
+			std::cout << std::fixed << std::setprecision(1)
+				<< "Position solver, " << (scene == 0 ? "pile" : "regression scene")
+				<< ", " << (solver == PositionSolver::PBD ? "PBD" : "pseudo velocities")
+				<< ":"
+				<< " step " << stepTime / MEASURED_STEPS << " us,"
+				<< std::setprecision(4)
+				<< " mean max penetration " << meanPenetration / MEASURED_STEPS << ","
+				<< " max penetration " << static_cast<double>(maxPenetration)
+				<< "\n";
+		}
+	}
+}
+
+/// Compares the Gauss-Seidel iterations with the direct solve
+/// of the small islands on separate stacks of boxes
+void runDirectSolveBenchmark()
+{
+	constexpr int STACK_COUNT = 150;
+	constexpr float MASS_RATIO = 10.0f;
+	constexpr uint32_t BODIES_TO_RESERVE = 1024;
+	constexpr uint32_t SETTLE_STEPS = 60;
+	constexpr uint32_t MEASURED_STEPS = 240;
+
+	struct Setup
+	{
+		/// Velocity iterations
+		uint32_t velocityIterations;
+
+		/// Maximum number of constraints of the directly solved islands
+		uint32_t directSolveMaxConstraints;
+	};
+
+	for (const int stackHeight : { 2, 5 })
+	{
+		// 2 contacts with 2 constraints each per box
+		const uint32_t stackConstraints = 4 * static_cast<uint32_t>(stackHeight);
+		for (const Setup setup : {
+			Setup{ SOLVER_VELOCITY_ITERATIONS, 0 },
+			Setup{ 2 * SOLVER_VELOCITY_ITERATIONS, 0 },
+			Setup{ SOLVER_VELOCITY_ITERATIONS, stackConstraints } })
+		{
+			World world(
+				GRAVITY,
+				setup.velocityIterations,
+				SOLVER_POSITION_ITERATIONS);
+
+			world.setDirectSolveMaxConstraints(setup.directSolveMaxConstraints);
+			world.reserveBodies(BODIES_TO_RESERVE);
+			createStacksScene(world, STACK_COUNT, stackHeight, MASS_RATIO);
+			for (uint32_t step = 0; step < SETTLE_STEPS; ++step)
+			{
+				world.doStep(TIME_STEP);
+			}
+
+			double stepTime = 0.0;
+			double velocityError = 0.0;
+			uint32_t maxIterationCount = 0;
+			for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+			{
+				const auto start = Clock::now();
+				world.doStep(TIME_STEP);
+				stepTime += getElapsedMicroseconds(start);
+
+				const ContactSolver& contactSolver = world.getContactSolver();
+				velocityError += static_cast<double>(contactSolver.getMaxVelocityError());
+				maxIterationCount = std::max(
+					maxIterationCount,
+					contactSolver.getDirectSolveStats().maxIterationCount);
+			}
+
+			std::cout << std::fixed << std::setprecision(1)
+				<< "Direct solve, stacks of " << stackHeight << ", "
+				<< setup.velocityIterations << " iterations, "
+				<< "max direct constraints " << setup.directSolveMaxConstraints << ":"
+				<< " step " << stepTime / MEASURED_STEPS << " us,"
+				<< std::setprecision(5)
+				<< " velocity error " << velocityError / MEASURED_STEPS << ","
+				<< " max direct iterations " << maxIterationCount
+				<< "\n";
+		}
+	}
+}
+
+/// Returns the kinetic energy of the bodies of the world
+double getKineticEnergy(const World& world)
+{
+	double result = 0.0;
+	for (const Body& body : world.getBodies())
+	{
+		result += 0.5 * static_cast<double>(
+			body.mass * dot(body.linearVelocity, body.linearVelocity) +
+			body.inertia * body.angularVelocity * body.angularVelocity);
+	}
+	return result;
+}
+
+/// Compares the shock propagation with the regular velocity iterations
+/// on the regression scene: the step time, the mean and the maximum
+/// kinetic energy after settling and the height of the pile.
+/// The requested shock iterations above half of the velocity iterations
+/// are ignored, so the last setup must match the previous one
+void runShockPropagationBenchmark()
+{
+	constexpr uint32_t BODIES_TO_RESERVE = 2048;
+	constexpr uint32_t SETTLE_STEPS = 600;
+	constexpr uint32_t MEASURED_STEPS = 300;
+
+	struct Setup
+	{
+		/// Velocity iterations
+		uint32_t velocityIterations;
+
+		/// Position iterations
+		uint32_t positionIterations;
+
+		/// Requested shock propagation iterations
+		uint32_t shockPropagationIterations;
+	};
+
+	for (const Setup setup : {
+		Setup{ SOLVER_VELOCITY_ITERATIONS, SOLVER_POSITION_ITERATIONS, 0 },
+		Setup{ 5, 2, 0 },
+		Setup{ 5, 2, 2 },
+		Setup{ 5, 2, 5 } })
+	{
+		World world(
+			GRAVITY,
+			setup.velocityIterations,
+			setup.positionIterations);
+
+		world.setShockPropagationIterations(setup.shockPropagationIterations);
+		world.reserveBodies(BODIES_TO_RESERVE);
+		createRegressionScene(world);
+		for (uint32_t step = 0; step < SETTLE_STEPS; ++step)
+		{
+			world.doStep(TIME_STEP);
+		}
+
+		double stepTime = 0.0;
+		double meanEnergy = 0.0;
+		double maxEnergy = 0.0;
+		for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+		{
+			const auto start = Clock::now();
+			world.doStep(TIME_STEP);
+			stepTime += getElapsedMicroseconds(start);
+
+			const double energy = getKineticEnergy(world);
+			meanEnergy += energy;
+			maxEnergy = std::max(maxEnergy, energy);
+		}
+
+		Real height = 0.0f;
+		for (const Body& body : world.getBodies())
+		{
+			if (!body.isStatic())
+			{
+				height = std::max(height, body.position.y);
+			}
+		}
+
+		std::cout << std::fixed << std::setprecision(1)
+			<< "Shock propagation, "
+			<< setup.velocityIterations << " / " << setup.positionIterations
+			<< " iterations, " << setup.shockPropagationIterations << " shock:"
+			<< " step " << stepTime / MEASURED_STEPS << " us,"
+			<< " mean kinetic energy " << meanEnergy / MEASURED_STEPS << ","
+			<< " max kinetic energy " << maxEnergy << ","
+			<< std::setprecision(2)
+			<< " height " << static_cast<double>(height)
+			<< "\n";
+	}
+}
+
+/// Measures the reuse of the prepared contact data on a settled pile
+void runContactReuseBenchmark()
+{
+	constexpr int COLUMN_COUNT = 100;
+	constexpr int ROW_COUNT = 20;
+	constexpr uint32_t BODIES_TO_RESERVE = 4096;
+	constexpr uint32_t SETTLE_STEPS = 300;
+	constexpr uint32_t MEASURED_STEPS = 300;
+
+	for (const bool enabled : { false, true })
+	{
+		World world(
+			GRAVITY,
+			SOLVER_VELOCITY_ITERATIONS,
+			SOLVER_POSITION_ITERATIONS);
+
+		ContactReuseSettings reuseSettings;
+		reuseSettings.enabled = enabled;
+		world.setContactReuseSettings(reuseSettings);
+		world.reserveBodies(BODIES_TO_RESERVE);
+		createPileScene(world, COLUMN_COUNT, ROW_COUNT);
+		for (uint32_t step = 0; step < SETTLE_STEPS; ++step)
+		{
+			world.doStep(TIME_STEP);
+		}
+
+		double stepTime = 0.0;
+		double velocityError = 0.0;
+		uint64_t contactCount = 0;
+		uint64_t reusedContactCount = 0;
+		for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+		{
+			const auto start = Clock::now();
+			world.doStep(TIME_STEP);
+			stepTime += getElapsedMicroseconds(start);
+
+			velocityError += static_cast<double>(
+				world.getContactSolver().getMaxVelocityError());
+			contactCount += world.getStats().contactCount;
+			reusedContactCount += world.getStats().reusedContactCount;
+		}
+
+		std::cout << std::fixed << std::setprecision(1)
+			<< "Contact reuse " << (enabled ? "enabled" : "disabled") << ":"
+			<< " step " << stepTime / MEASURED_STEPS << " us,"
+			<< " hit rate " << 100.0 * static_cast<double>(reusedContactCount) /
+				static_cast<double>(std::max<uint64_t>(contactCount, 1)) << "%,"
+			<< std::setprecision(4)
+			<< " velocity error " << velocityError / MEASURED_STEPS
+			<< "\n";
+	}
+}
+
+/// Measures the cost of the rollback buffer: saving of a state after each step
+/// and rewinding with the following resimulation
+void runRollbackBenchmark(uint32_t keyframeInterval)
+{
+	constexpr int COLUMN_COUNT = 100;
+	constexpr int ROW_COUNT = 100;
+	constexpr uint32_t SETTLE_STEPS = 60;
+	constexpr uint32_t CAPACITY = 16;
+	constexpr uint32_t MEASURED_STEPS = 64;
+	constexpr uint32_t STEPS_BACK = 8;
+
+	World world(
+		GRAVITY,
+		SOLVER_VELOCITY_ITERATIONS,
+		SOLVER_POSITION_ITERATIONS);
+
+	world.reserveBodies(COLUMN_COUNT * ROW_COUNT + 1);
+	createPileScene(world, COLUMN_COUNT, ROW_COUNT);
+	for (uint32_t step = 0; step < SETTLE_STEPS; ++step)
+	{
+		world.doStep(TIME_STEP);
+	}
+
+	// Step and save time, the states are saved into a separate buffer
+	// to measure the save cost alone
+	RollbackBuffer buffer(CAPACITY, keyframeInterval);
+	double stepTime = 0.0;
+	double saveTime = 0.0;
+	for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+	{
+		auto start = Clock::now();
+		world.doStep(TIME_STEP);
+		stepTime += getElapsedMicroseconds(start);
+
+		start = Clock::now();
+		buffer.save(
+			world.getBodies(),
+			world.getCollision().getBroadPhase(),
+			world.getContactSolver());
+		saveTime += getElapsedMicroseconds(start);
+	}
+	stepTime /= MEASURED_STEPS;
+	saveTime /= MEASURED_STEPS;
+
+	// Rewind time, each rewind is followed by a resimulation
+	// to refill the buffer
+	world.setRollbackCapacity(CAPACITY, keyframeInterval);
+	for (uint32_t step = 0; step < STEPS_BACK; ++step)
+	{
+		world.doStep(TIME_STEP);
+	}
+
+	double rewindTime = 0.0;
+	for (uint32_t i = 0; i < MEASURED_STEPS; ++i)
+	{
+		const auto start = Clock::now();
+		if (!world.rewind(STEPS_BACK))
+		{
+			logError("Failed to rewind the world.");
+			return;
+		}
+		rewindTime += getElapsedMicroseconds(start);
+
+		for (uint32_t step = 0; step < STEPS_BACK; ++step)
+		{
+			world.doStep(TIME_STEP);
+		}
+	}
+	rewindTime /= MEASURED_STEPS;
+
+	const double scale =
+		BODIES_PER_RESULT / static_cast<double>(world.getBodies().size());
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< "Rollback, keyframe interval " << keyframeInterval << ":"
+		<< " step " << stepTime * scale << " us,"
+		<< " save " << saveTime * scale << " us,"
+		<< " rewind " << rewindTime * scale << " us,"
+		<< " memory " << buffer.getMemoryUsage() * scale / 1024.0 << " KB"
+		<< " (per 10k bodies)\n";
+}
+
+/// Measures the state encoding: encoding and decoding time
+/// and the packet size of a settling pile
+void runStateEncodingBenchmark()
+{
+	constexpr int COLUMN_COUNT = 100;
+	constexpr int ROW_COUNT = 100;
+	constexpr uint32_t MEASURED_STEPS = 120;
+
+	World world(
+		GRAVITY,
+		SOLVER_VELOCITY_ITERATIONS,
+		SOLVER_POSITION_ITERATIONS);
+
+	world.reserveBodies(COLUMN_COUNT * ROW_COUNT + 1);
+	createPileScene(world, COLUMN_COUNT, ROW_COUNT);
+
+	StateEncoder encoder;
+	StateDecoder decoder;
+	std::vector<uint8_t> packet;
+
+	// The first packet contains all bodies
+	encoder.encode(world.getBodies(), packet);
+	const size_t fullPacketSize = packet.size();
+	decoder.decode(packet);
+
+	double encodeTime = 0.0;
+	double decodeTime = 0.0;
+	size_t deltaPacketSize = 0;
+	for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+	{
+		world.doStep(TIME_STEP);
+
+		packet.clear();
+		auto start = Clock::now();
+		encoder.encode(world.getBodies(), packet);
+		encodeTime += getElapsedMicroseconds(start);
+
+		start = Clock::now();
+		if (!decoder.decode(packet))
+		{
+			logError("Failed to decode a state packet.");
+			return;
+		}
+		decodeTime += getElapsedMicroseconds(start);
+		deltaPacketSize += packet.size();
+	}
+
+	const double scale =
+		BODIES_PER_RESULT / static_cast<double>(world.getBodies().size());
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< "State encoding:"
+		<< " encode " << encodeTime / MEASURED_STEPS * scale << " us,"
+		<< " decode " << decodeTime / MEASURED_STEPS * scale << " us,"
+		<< " full packet " << fullPacketSize * scale / 1024.0 << " KB,"
+		<< " delta packet " << deltaPacketSize / MEASURED_STEPS * scale / 1024.0 << " KB"
+		<< " (per 10k bodies)\n";
+}
+
+/// Measures the recording of a binary trajectory of a settling pile:
+/// write time and size of a frame
+void runTrajectoryBenchmark(bool compress)
+{
+	constexpr int COLUMN_COUNT = 100;
+	constexpr int ROW_COUNT = 100;
+	constexpr uint32_t MEASURED_STEPS = 120;
+
+	World world(
+		GRAVITY,
+		SOLVER_VELOCITY_ITERATIONS,
+		SOLVER_POSITION_ITERATIONS);
+
+	world.reserveBodies(COLUMN_COUNT * ROW_COUNT + 1);
+	createPileScene(world, COLUMN_COUNT, ROW_COUNT);
+
+	const std::filesystem::path path =
+		std::filesystem::temp_directory_path() / "nph_benchmark_trajectory.bin";
+
+	TrajectoryWriter writer;
+	if (!writer.open(path, compress))
+	{
+		logError("Failed to open the trajectory file.");
+		return;
+	}
+
+	double writeTime = 0.0;
+	for (uint32_t step = 0; step < MEASURED_STEPS; ++step)
+	{
+		world.doStep(TIME_STEP);
+
+		const auto start = Clock::now();
+		writer.writeFrame(step, world.getBodies());
+		writeTime += getElapsedMicroseconds(start);
+	}
+
+	if (!writer.close())
+	{
+		logError("Failed to write the trajectory file.");
+		return;
+	}
+
+	const double scale =
+		BODIES_PER_RESULT / static_cast<double>(world.getBodies().size());
+	const double frameSize =
+		static_cast<double>(std::filesystem::file_size(path)) / MEASURED_STEPS;
+	std::filesystem::remove(path);
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< "Trajectory, " << (compress ? "compressed" : "raw") << ":"
+		<< " write " << writeTime / MEASURED_STEPS * scale << " us,"
+		<< " frame " << frameSize * scale / 1024.0 << " KB"
+		<< " (per 10k bodies)\n";
+}
+
+} // anonymous namespace
+
+/// Performance benchmarks of the engine features
+int main()
+{
+	try
+	{
+		runStepBenchmark();
+		runStepConfigBenchmark();
+		runKernelIsaBenchmark();
+		runVelocitySolverBenchmark();
+		runPositionSolverBenchmark();
+		runDirectSolveBenchmark();
+		runShockPropagationBenchmark();
+		runContactReuseBenchmark();
+		runRollbackBenchmark(1);
+		runRollbackBenchmark(4);
+		runStateEncodingBenchmark();
+		runTrajectoryBenchmark(false);
+		runTrajectoryBenchmark(true);
+		return 0;
+	}
+	catch (const std::exception& exception)
+	{
+		logError("Exception caught: ", exception.what());
+	}
+	catch (...)
+	{
+		logError("Unknown exception caught.");
+	}
+	return -1;
+}
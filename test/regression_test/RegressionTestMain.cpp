@@ -4,10 +4,11 @@
 
 // Includes
 #include <filesystem>
-#include <fstream>
 #include <random>
 #include "neat_physics/World.h"
 #include "Core.h"
+#include "Trajectory.h"
+#include "TrajectoryComparison.h"
 #include "Visualization.h"
 
 using namespace nph;
@@ -86,7 +87,13 @@ void createTestScene(World& world)
 
 } // anonymous namespace
 
-/// A little regression test that runs a simulation and dumps body positions
+/// A little regression test that runs a simulation and records body positions
+/// to a binary trajectory; use trajectory_tool to convert it to text.
+/// If a reference trajectory is given, e.g. recorded by
+/// regression_test_std_sincos with std::sin and std::cos
+/// (see NPH_FAST_SIN_COS), the results must match it within the default
+/// comparison tolerances up to LAST_REFERENCE_STEP; after that the pile
+/// diverges chaotically from any small difference.
 int wmain(int argc, wchar_t** argv)
 {
 	constexpr float TIME_STEP = 1.0f / 60.0f;
@@ -98,13 +105,15 @@ int wmain(int argc, wchar_t** argv)
 
 	constexpr uint32_t MAX_STEPS = 400;
 	constexpr uint32_t DUMP_INTERVAL = 10;
+	constexpr uint32_t LAST_REFERENCE_STEP = 90;
 
 	try
 	{
-		if (argc != 2)
+		if (argc != 2 && argc != 3)
 		{
 			logError("Invalid command line arguments.");
-			logError("Correct usage: program.exe path_to_output_directory");
+			logError("Correct usage: program.exe path_to_output_directory "
+				"[path_to_reference_trajectory.bin]");
 			return -1;
 		}
 
@@ -132,28 +141,20 @@ int wmain(int argc, wchar_t** argv)
 		std::filesystem::path outputDirectory =
 			std::filesystem::canonical(std::wstring(argv[1]));
 
-		auto resultFile =
-			std::ofstream(outputDirectory.wstring() + L"\\results.txt");
-		if (!resultFile)
+		TrajectoryWriter resultWriter;
+		if (!resultWriter.open(outputDirectory / L"results.bin", true))
 		{
 			logError("Failed to open results file.");
 			return -1;
 		}
 
-		
-		for (int step = 0; step < MAX_STEPS; ++step)
+		for (uint32_t step = 0; step < MAX_STEPS; ++step)
 		{
-			if (step % DUMP_INTERVAL == 0)
+			if (step % DUMP_INTERVAL == 0 &&
+				!resultWriter.writeFrame(step, world.getBodies()))
 			{
-				resultFile << "Step " << step << ":\n";
-				for (size_t i = 0; i < world.getBodies().size(); ++i)
-				{
-					const Body& body = world.getBodies()[i];
-					resultFile << "Body " << i << ": ";
-					resultFile << "Pos(" << body.position.x << ", " << body.position.y << ") ";
-					resultFile << "Rot(" << body.rotation.getAngle() << ")\n";
-				}
-				resultFile << "\n";
+				logError("Failed to write results.");
+				return -1;
 			}
 
 			world.doStep(TIME_STEP);
@@ -166,6 +167,47 @@ int wmain(int argc, wchar_t** argv)
 				visualization->endFrame();
 			}
 		}
+
+		if (!resultWriter.close())
+		{
+			logError("Failed to write results.");
+			return -1;
+		}
+
+		if (argc == 3)
+		{
+			TrajectoryReader reference;
+			TrajectoryReader results;
+			if (!reference.open(std::filesystem::path(argv[2])) ||
+				!results.open(outputDirectory / L"results.bin"))
+			{
+				logError("Failed to open the reference trajectory or the results.");
+				return -1;
+			}
+
+			const TrajectoryComparison comparison = compareTrajectories(
+				reference,
+				results,
+				ComparisonTolerances{},
+				LAST_REFERENCE_STEP);
+
+			if (!comparison.error.empty())
+			{
+				logError("Failed to compare with the reference: ", comparison.error);
+				return -1;
+			}
+
+			std::cout << "\nReference comparison up to step " << LAST_REFERENCE_STEP
+				<< ": max position error " << comparison.total.position.max
+				<< ", max rotation error " << comparison.total.rotation.max << "\n";
+
+			if (comparison.hasDivergence)
+			{
+				logError("The results diverge from the reference at step ",
+					comparison.divergentStep, ", body ", comparison.divergentBody, ".");
+				return -1;
+			}
+		}
 		return 0;
 	}
 	catch (const std::exception& exception)
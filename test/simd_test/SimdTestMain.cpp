@@ -0,0 +1,440 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include "neat_physics/math/simd/Simd.h"
+#include "Core.h"
+
+using namespace nph;
+
+namespace
+{
+
+/// Number of random trials per test
+constexpr uint32_t TRIALS = 10000;
+
+/// Maximum relative error of the fast reciprocal and reciprocal square root
+constexpr float MAX_FAST_RELATIVE_ERROR = 1.0e-6f;
+
+/// Maximum absolute difference of the wide and the scalar vector operations
+/// Outside the deterministic mode the compiler may contract
+/// multiplications and additions into FMA differently in the two
+constexpr float MAX_VECTOR_DIFFERENCE = NPH_DETERMINISTIC ? 0.0f : 1.0e-4f;
+
+/// Random number generator shared by the tests
+std::mt19937 randomEngine(42);
+
+/// Returns a random value in [-range, range]
+float getRandom(float range)
+{
+	return std::uniform_real_distribution<float>(-range, range)(randomEngine);
+}
+
+/// Fills an array with random values in [-range, range]
+/// Some values are replaced with zero and duplicated to test the edge cases
+template <uint32_t SIZE>
+void fillRandom(float (&values)[SIZE], float range)
+{
+	for (float& value : values)
+	{
+		const uint32_t kind = randomEngine() % 16;
+		value = (kind == 0) ? 0.0f : getRandom(range);
+	}
+	values[randomEngine() % SIZE] = values[randomEngine() % SIZE];
+}
+
+/// Reports a test failure
+/// \return false
+bool fail(const char* isaName, const char* testName, uint32_t lane)
+{
+	logError(isaName, ": ", testName, " failed in lane ", lane, ".");
+	return false;
+}
+
+/// Tests the arithmetic, the comparisons and the selection
+/// against the scalar operations
+template <typename FloatW>
+bool testArithmetic()
+{
+	constexpr uint32_t W = FloatW::WIDTH;
+	for (uint32_t trial = 0; trial < TRIALS; ++trial)
+	{
+		float a[W];
+		float b[W];
+		fillRandom(a, 100.0f);
+		fillRandom(b, 100.0f);
+		const FloatW wideA = FloatW::load(a);
+		const FloatW wideB = FloatW::load(b);
+
+		float sum[W], difference[W], product[W], quotient[W];
+		float minimum[W], maximum[W], absolute[W], root[W], selected[W];
+		(wideA + wideB).store(sum);
+		(wideA - wideB).store(difference);
+		(wideA * wideB).store(product);
+		(wideA / wideB).store(quotient);
+		min(wideA, wideB).store(minimum);
+		max(wideA, wideB).store(maximum);
+		abs(-wideA).store(absolute);
+		sqrt(abs(wideA)).store(root);
+
+		const auto less = wideA < wideB;
+		select(less, wideA, wideB).store(selected);
+
+		const uint32_t lessBits = less.getBits();
+		const uint32_t lessEqualBits = (wideA <= wideB).getBits();
+		const uint32_t greaterBits = (wideA > wideB).getBits();
+		const uint32_t equalBits = (wideA == wideB).getBits();
+		const uint32_t notEqualBits = (wideA != wideB).getBits();
+		if (less.any() != (lessBits != 0) ||
+			less.all() != (lessBits == (1u << W) - 1u) ||
+			(~less).getBits() != (lessBits ^ ((1u << W) - 1u)) ||
+			(less & (wideA == wideB)).any() ||
+			(less | (wideA >= wideB)).getBits() != (1u << W) - 1u)
+		{
+			return fail(FloatW::ISA_NAME, "mask operations", 0);
+		}
+
+		for (uint32_t i = 0; i < W; ++i)
+		{
+			const bool quotientOk = (b[i] == 0.0f) ?
+				std::isinf(quotient[i]) || std::isnan(quotient[i]) :
+				quotient[i] == a[i] / b[i];
+			if (sum[i] != a[i] + b[i] ||
+				difference[i] != a[i] - b[i] ||
+				product[i] != a[i] * b[i] ||
+				!quotientOk ||
+				minimum[i] != std::min(a[i], b[i]) ||
+				maximum[i] != std::max(a[i], b[i]) ||
+				absolute[i] != std::fabs(a[i]) ||
+				root[i] != std::sqrt(std::fabs(a[i])) ||
+				selected[i] != (a[i] < b[i] ? a[i] : b[i]) ||
+				((lessBits >> i) & 1u) != uint32_t(a[i] < b[i]) ||
+				((lessEqualBits >> i) & 1u) != uint32_t(a[i] <= b[i]) ||
+				((greaterBits >> i) & 1u) != uint32_t(a[i] > b[i]) ||
+				((equalBits >> i) & 1u) != uint32_t(a[i] == b[i]) ||
+				((notEqualBits >> i) & 1u) != uint32_t(a[i] != b[i]) ||
+				wideA.getLane(i) != a[i])
+			{
+				return fail(FloatW::ISA_NAME, "arithmetic", i);
+			}
+		}
+
+		for (uint32_t count = 0; count <= W; ++count)
+		{
+			if (FloatW::Mask::firstLanes(count).getBits() != (1u << count) - 1u)
+			{
+				return fail(FloatW::ISA_NAME, "first lanes mask", count);
+			}
+		}
+	}
+	return true;
+}
+
+/// Tests the fast reciprocal and reciprocal square root accuracy
+template <typename FloatW>
+bool testReciprocals()
+{
+	constexpr uint32_t W = FloatW::WIDTH;
+	for (uint32_t trial = 0; trial < TRIALS; ++trial)
+	{
+		// Values over many orders of magnitude
+		float values[W];
+		for (float& value : values)
+		{
+			value = std::ldexp(1.0f + std::fabs(getRandom(1.0f)),
+				static_cast<int>(randomEngine() % 64) - 32);
+		}
+
+		float inverse[W];
+		float inverseRoot[W];
+		const FloatW wide = FloatW::load(values);
+		reciprocal(wide).store(inverse);
+		reciprocalSqrt(wide).store(inverseRoot);
+		for (uint32_t i = 0; i < W; ++i)
+		{
+			const double exactInverse = 1.0 / values[i];
+			const double exactInverseRoot = 1.0 / std::sqrt(double(values[i]));
+			if (std::abs(inverse[i] - exactInverse) >
+					MAX_FAST_RELATIVE_ERROR * exactInverse ||
+				std::abs(inverseRoot[i] - exactInverseRoot) >
+					MAX_FAST_RELATIVE_ERROR * exactInverseRoot)
+			{
+				return fail(FloatW::ISA_NAME, "reciprocals", i);
+			}
+		}
+	}
+	return true;
+}
+
+/// Checks if two values are equal within MAX_VECTOR_DIFFERENCE
+bool isNear(float a, float b)
+{
+	return std::fabs(a - b) <= MAX_VECTOR_DIFFERENCE;
+}
+
+/// Tests the wide vector, matrix and rotation operations
+/// against the scalar ones; in the deterministic mode they must be bit-exact
+template <typename FloatW>
+bool testVectors()
+{
+	using Vec2W = simd::BasicVec2W<FloatW>;
+	using Mat22W = simd::BasicMat22W<FloatW>;
+	using RotationW = simd::BasicRotationW<FloatW>;
+
+	constexpr uint32_t W = FloatW::WIDTH;
+	for (uint32_t trial = 0; trial < TRIALS; ++trial)
+	{
+		float values[7][W];
+		for (auto& lanes : values)
+		{
+			fillRandom(lanes, 10.0f);
+		}
+
+		const Vec2W vecA(FloatW::load(values[0]), FloatW::load(values[1]));
+		const Vec2W vecB(FloatW::load(values[2]), FloatW::load(values[3]));
+		const FloatW z = FloatW::load(values[4]);
+		const Mat22W mat(vecA, vecB);
+
+		float cosines[W];
+		float sines[W];
+		for (uint32_t i = 0; i < W; ++i)
+		{
+			const Rotation scalarRotation(values[5][i]);
+			cosines[i] = scalarRotation.getMat().col1.x;
+			sines[i] = scalarRotation.getMat().col1.y;
+		}
+		const RotationW rotation{
+			FloatW::load(cosines),
+			FloatW::load(sines) };
+
+		const FloatW dotProduct = dot(vecA, vecB);
+		const FloatW crossProduct = cross(vecA, vecB);
+		const Vec2W crossVecZ = cross(vecA, z);
+		const Vec2W crossZVec = cross(z, vecA);
+		const Vec2W combination = z * (vecA + vecB) - abs(vecB);
+		const Vec2W selected = select(vecA.x < vecB.x, vecA, vecB);
+		const Vec2W transformed = mat.getTransposed() * vecB;
+		const Vec2W rotated = rotation.rotate(vecA);
+		const Vec2W inverseRotated = rotation.inverseRotate(vecA);
+		const Vec2W rotatedByMat = rotation.getMat() * vecA;
+
+		for (uint32_t i = 0; i < W; ++i)
+		{
+			const Vec2 a = vecA.getLane(i);
+			const Vec2 b = vecB.getLane(i);
+			const Real zi = z.getLane(i);
+			const Mat22 scalarMat(a, b);
+			const Rotation scalarRotation(values[5][i]);
+
+			const auto equal = [](const Vec2& u, const Vec2& v)
+			{
+				return isNear(u.x, v.x) && isNear(u.y, v.y);
+			};
+
+			if (!isNear(dotProduct.getLane(i), nph::dot(a, b)) ||
+				!isNear(crossProduct.getLane(i), nph::cross(a, b)) ||
+				!equal(crossVecZ.getLane(i), nph::cross(a, zi)) ||
+				!equal(crossZVec.getLane(i), nph::cross(zi, a)) ||
+				!equal(combination.getLane(i), zi * (a + b) - nph::abs(b)) ||
+				!equal(selected.getLane(i), a.x < b.x ? a : b) ||
+				!equal(transformed.getLane(i), scalarMat.getTransposed() * b) ||
+				!equal(rotated.getLane(i), scalarRotation.getMat() * a) ||
+				!equal(rotatedByMat.getLane(i), scalarRotation.getMat() * a) ||
+				!equal(
+					inverseRotated.getLane(i),
+					scalarRotation.getInverseMat() * a))
+			{
+				return fail(FloatW::ISA_NAME, "vectors", i);
+			}
+		}
+	}
+	return true;
+}
+
+/// Tests the polynomial sine and cosine: the error bound of the scalar
+/// variant and the wide variant against the scalar one
+template <typename FloatW>
+bool testSinCos()
+{
+	constexpr uint32_t W = FloatW::WIDTH;
+	for (uint32_t trial = 0; trial < TRIALS; ++trial)
+	{
+		// Angles of the usual body rotations and up to the maximum angle
+		float angles[W];
+		fillRandom(angles, trial % 2 == 0 ? 10.0f : FAST_SIN_COS_MAX_ANGLE);
+
+		const BasicSinCos<FloatW> wide = fastSinCos(FloatW::load(angles));
+		for (uint32_t i = 0; i < W; ++i)
+		{
+			const BasicSinCos<float> scalar = fastSinCos(angles[i]);
+			const double angle = angles[i];
+			if (std::abs(scalar.sin - std::sin(angle)) > FAST_SIN_COS_MAX_ERROR ||
+				std::abs(scalar.cos - std::cos(angle)) > FAST_SIN_COS_MAX_ERROR)
+			{
+				return fail(FloatW::ISA_NAME, "sincos error", i);
+			}
+
+			if (!isNear(wide.sin.getLane(i), scalar.sin) ||
+				!isNear(wide.cos.getLane(i), scalar.cos))
+			{
+				return fail(FloatW::ISA_NAME, "sincos", i);
+			}
+		}
+	}
+	return true;
+}
+
+/// Tests gathering bodies from and scattering them to a body array
+template <typename FloatW>
+bool testGatherScatter()
+{
+	using BodyW = simd::BasicBodyW<FloatW>;
+
+	constexpr uint32_t W = FloatW::WIDTH;
+	constexpr uint32_t BODY_COUNT = 64;
+
+	BodyArray bodies;
+	for (uint32_t i = 0; i < BODY_COUNT; ++i)
+	{
+		bodies.emplace_back(Vec2(1.0f, 2.0f), (i % 8 == 0) ? 0.0f : 1.0f + i, 0.5f);
+		Body& body = bodies.back();
+		body.position.set(getRandom(100.0f), getRandom(100.0f));
+		body.rotation.setAngle(getRandom(3.0f));
+		body.linearVelocity.set(getRandom(10.0f), getRandom(10.0f));
+		body.angularVelocity = getRandom(10.0f);
+	}
+
+	std::vector<uint32_t> indices(BODY_COUNT);
+	std::iota(indices.begin(), indices.end(), 0);
+	for (uint32_t trial = 0; trial < TRIALS / 10; ++trial)
+	{
+		std::shuffle(indices.begin(), indices.end(), randomEngine);
+		const uint32_t count = randomEngine() % (W + 1);
+
+		BodyW wide = BodyW::gather(bodies.data(), indices.data(), count);
+		for (uint32_t i = 0; i < W; ++i)
+		{
+			if (i >= count)
+			{
+				if (wide.invMass.getLane(i) != 0.0f ||
+					wide.rotation.cos.getLane(i) != 1.0f ||
+					wide.rotation.sin.getLane(i) != 0.0f ||
+					wide.linearVelocity.x.getLane(i) != 0.0f)
+				{
+					return fail(FloatW::ISA_NAME, "gather padding", i);
+				}
+				continue;
+			}
+
+			const Body& body = bodies[indices[i]];
+			if (wide.position.x.getLane(i) != body.position.x ||
+				wide.position.y.getLane(i) != body.position.y ||
+				wide.angle.getLane(i) != body.rotation.getAngle() ||
+				wide.rotation.cos.getLane(i) != body.rotation.getMat().col1.x ||
+				wide.rotation.sin.getLane(i) != body.rotation.getMat().col1.y ||
+				wide.linearVelocity.x.getLane(i) != body.linearVelocity.x ||
+				wide.linearVelocity.y.getLane(i) != body.linearVelocity.y ||
+				wide.angularVelocity.getLane(i) != body.angularVelocity ||
+				wide.invMass.getLane(i) != body.invMass ||
+				wide.invInertia.getLane(i) != body.invInertia)
+			{
+				return fail(FloatW::ISA_NAME, "gather", i);
+			}
+		}
+
+		// Modify only the gathered lanes through a mask
+		const auto mask = FloatW::Mask::firstLanes(count);
+		wide.linearVelocity = select(
+			mask,
+			FloatW(0.5f) * wide.linearVelocity,
+			wide.linearVelocity);
+		wide.angularVelocity = -wide.angularVelocity;
+		wide.position += wide.linearVelocity;
+		wide.angle += FloatW(0.25f);
+
+		const BodyArray original = bodies;
+		wide.scatterVelocities(bodies.data(), indices.data(), count);
+		wide.scatterPositions(bodies.data(), indices.data(), count);
+		for (uint32_t i = 0; i < BODY_COUNT; ++i)
+		{
+			const auto lane = std::find(
+				indices.begin(),
+				indices.begin() + count,
+				i) - indices.begin();
+			const Body& before = original[i];
+			const Body& after = bodies[i];
+			if (lane == count)
+			{
+				if (after.position.x != before.position.x ||
+					after.linearVelocity.x != before.linearVelocity.x ||
+					after.angularVelocity != before.angularVelocity ||
+					after.rotation.getAngle() != before.rotation.getAngle())
+				{
+					return fail(FloatW::ISA_NAME, "scatter of other bodies", i);
+				}
+				continue;
+			}
+
+			const Vec2 velocity = 0.5f * before.linearVelocity;
+			const Vec2 position = before.position + velocity;
+			const Rotation rotation(before.rotation.getAngle() + 0.25f);
+			if (after.linearVelocity.x != velocity.x ||
+				after.linearVelocity.y != velocity.y ||
+				after.angularVelocity != -before.angularVelocity ||
+				after.position.x != position.x ||
+				after.position.y != position.y ||
+				after.rotation.getAngle() != rotation.getAngle() ||
+				after.rotation.getMat().col1.x != rotation.getMat().col1.x)
+			{
+				return fail(FloatW::ISA_NAME, "scatter", static_cast<uint32_t>(lane));
+			}
+		}
+	}
+	return true;
+}
+
+/// Runs all tests for a backend
+/// \return true if all tests passed
+template <typename FloatW>
+bool runTests()
+{
+	const bool passed =
+		testArithmetic<FloatW>() &&
+		testReciprocals<FloatW>() &&
+		testVectors<FloatW>() &&
+		testSinCos<FloatW>() &&
+		testGatherScatter<FloatW>();
+	std::cout << FloatW::ISA_NAME << " (" << FloatW::WIDTH << " lanes): "
+		<< (passed ? "passed" : "FAILED") << "\n";
+	return passed;
+}
+
+} // anonymous namespace
+
+/// Tests of the wide (SIMD) types: the scalar emulation and the native
+/// backend of the build are checked against the scalar engine math
+int main()
+{
+	try
+	{
+		bool passed = runTests<simd::scalar::FloatW>();
+#if NPH_SIMD_ISA != NPH_SIMD_SCALAR
+		passed = runTests<simd::native::FloatW>() && passed;
+#endif
+		return passed ? 0 : -1;
+	}
+	catch (const std::exception& exception)
+	{
+		logError("Exception caught: ", exception.what());
+	}
+	catch (...)
+	{
+		logError("Unknown exception caught.");
+	}
+	return -1;
+}
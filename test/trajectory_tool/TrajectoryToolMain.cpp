@@ -0,0 +1,165 @@
+// A minimalistic 2D physics engine (https://github.com/dmitry-sapelnikov/neat-physics)
+// SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
+// SPDX-License-Identifier: MIT
+
+// Includes
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include "Core.h"
+#include "MappedFile.h"
+#include "Trajectory.h"
+#include "TrajectoryComparison.h"
+
+using namespace nph;
+
+namespace
+{
+
+/// Converts a binary trajectory to the text format
+/// \return the exit code
+int convertToText(
+	const std::filesystem::path& inputPath,
+	const std::filesystem::path& outputPath)
+{
+	TrajectoryReader reader;
+	if (!reader.open(inputPath))
+	{
+		logError("Failed to open the trajectory file.");
+		return -1;
+	}
+
+	std::ofstream output(outputPath);
+	if (!output)
+	{
+		logError("Failed to open the output file.");
+		return -1;
+	}
+
+	if (!convertTrajectoryToText(reader, output))
+	{
+		logError("Failed to convert the trajectory.");
+		return -1;
+	}
+	return 0;
+}
+
+/// Opens a trajectory, memory-mapping the file if possible
+/// \return true on success
+bool openTrajectory(
+	const std::filesystem::path& path,
+	MappedFile& mappedFile,
+	TrajectoryReader& reader)
+{
+	return mappedFile.open(path) ?
+		reader.open(mappedFile.getData()) :
+		reader.open(path);
+}
+
+/// Prints error statistics
+void printErrors(const char* name, const ErrorStatistics& errors)
+{
+	std::cout << name
+		<< ": max " << errors.max
+		<< ", mean " << errors.getMean() << "\n";
+}
+
+/// Compares two binary trajectories
+/// \return the exit code: 0 if the trajectories match within the tolerances
+int compare(
+	const std::filesystem::path& referencePath,
+	const std::filesystem::path& actualPath,
+	const ComparisonTolerances& tolerances)
+{
+	MappedFile referenceFile;
+	TrajectoryReader reference;
+	if (!openTrajectory(referencePath, referenceFile, reference))
+	{
+		logError("Failed to open the reference trajectory.");
+		return -1;
+	}
+
+	MappedFile actualFile;
+	TrajectoryReader actual;
+	if (!openTrajectory(actualPath, actualFile, actual))
+	{
+		logError("Failed to open the actual trajectory.");
+		return -1;
+	}
+
+	const TrajectoryComparison comparison =
+		compareTrajectories(reference, actual, tolerances);
+	if (!comparison.error.empty())
+	{
+		logError("Failed to compare the trajectories: ", comparison.error);
+		return -1;
+	}
+
+	std::cout << std::setprecision(9)
+		<< "Frames: " << comparison.frameCount
+		<< ", body states: " << comparison.bodyStepCount << "\n";
+	printErrors("Position error", comparison.total.position);
+	printErrors("Rotation error", comparison.total.rotation);
+
+	if (comparison.hasDivergence)
+	{
+		const TrajectoryErrors& body = comparison.bodies[comparison.divergentBody];
+		std::cout
+			<< "FAILED: first divergence at step " << comparison.divergentStep
+			<< ", body " << comparison.divergentBody << "\n";
+		printErrors("Divergent body position error", body.position);
+		printErrors("Divergent body rotation error", body.rotation);
+		return -1;
+	}
+
+	std::cout << "PASSED\n";
+	return 0;
+}
+
+/// Logs the usage of the tool
+void logUsage()
+{
+	logError("Correct usage:");
+	logError("  program.exe text path_to_trajectory.bin path_to_output.txt");
+	logError("  program.exe compare path_to_reference.bin path_to_actual.bin "
+		"[position_tolerance rotation_tolerance]");
+}
+
+} // anonymous namespace
+
+/// Tool for the binary trajectories of the regression test
+int wmain(int argc, wchar_t** argv)
+{
+	try
+	{
+		if (argc == 4 && std::wstring(argv[1]) == L"text")
+		{
+			return convertToText(argv[2], argv[3]);
+		}
+
+		if ((argc == 4 || argc == 6) && std::wstring(argv[1]) == L"compare")
+		{
+			ComparisonTolerances tolerances;
+			if (argc == 6)
+			{
+				tolerances.position = std::stof(argv[4]);
+				tolerances.rotation = std::stof(argv[5]);
+			}
+			return compare(argv[2], argv[3], tolerances);
+		}
+
+		logError("Invalid command line arguments.");
+		logUsage();
+		return -1;
+	}
+	catch (const std::exception& exception)
+	{
+		logError("Exception caught: ", exception.what());
+	}
+	catch (...)
+	{
+		logError("Unknown exception caught.");
+	}
+	return -1;
+}
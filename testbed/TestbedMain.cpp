@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: 2025 Dmitry Sapelnikov
 // SPDX-License-Identifier: MIT
 
+#include <algorithm>
 #include <chrono>
 #include "Core.h"
 #include "Visualization.h"
@@ -42,6 +43,9 @@ struct SimulationControl
 	/// Box side ratio (height / width)
 	float boxSideRatio{ 0.5f };
 
+	/// Bullet flag of newly created boxes
+	bool bulletBoxes{ false };
+
 	/// Time step frequency
 	float timeStepFrequency{ 50.0f };
 
@@ -50,6 +54,30 @@ struct SimulationControl
 
 	/// Position solver iterations
 	int positionIterations{ 10 };
+
+	/// Speculative contacts flag
+	bool speculativeContacts{ false };
+
+	/// Adaptive substepping flag
+	bool adaptiveSubsteps{ false };
+
+	/// Final velocity iterations with the shock propagation
+	int shockPropagationIterations{ 0 };
+
+	/// Velocity solver, see nph::VelocitySolver
+	int velocitySolver{ 0 };
+
+	/// Position solver, see nph::PositionSolver
+	int positionSolver{ 0 };
+
+	/// Relaxation of the Jacobi velocity solver
+	float jacobiRelaxation{ 0.25f };
+
+	/// Maximum number of constraints of an island solved directly
+	int directSolveMaxConstraints{ 0 };
+
+	/// Reuse of the prepared contact data flag
+	bool contactReuse{ false };
 };
 
 /// Creates a 'glass-shaped' container
@@ -104,11 +132,15 @@ void addBoxOnMouseClick(
 	const float boxSizeY = boxSizeX * simulationControl.boxSideRatio;
 	const float boxMass = boxSizeX * boxSizeY * simulationControl.boxDensity;
 
-	world.addBody(
+	nph::Body* body = world.addBody(
 		{ boxSizeX, boxSizeY },
 		boxMass,
 		simulationControl.friction,
 		visualization->getCursorPositionWorld());
+	if (body != nullptr)
+	{
+		body->isBullet = simulationControl.bulletBoxes;
+	}
 }
 
 /// Draws ImGui controls
@@ -141,7 +173,9 @@ void drawGui(
 		ImGui::BulletText(
 			"To create walls with nonzero friction,\n"
 			"set friction first, then press Reset.");
-		ImGui::BulletText("Disable VSync to speed up the simulation.");
+		ImGui::BulletText(
+			"The simulation runs in real time\n"
+			"at the time step frequency.");
 	}
 
 	if (ImGui::CollapsingHeader("Visualization"))
@@ -199,15 +233,49 @@ void drawGui(
 			"Physics FPS: %.1f",
 			1.0f / lastPhysicsStepTime);
 
+		ImGui::Text(
+			"Substeps: %u",
+			world.getStats().substepCount);
+
+		std::vector<nph::Real> islandMassRatios;
+		world.getIslandMassRatios(islandMassRatios);
+		ImGui::Text(
+			"Islands: %zu, Max Mass Ratio: %.1f",
+			islandMassRatios.size(),
+			islandMassRatios.empty() ? 1.0f : *std::max_element(
+				islandMassRatios.begin(),
+				islandMassRatios.end()));
+
+		ImGui::Text(
+			"Contacts: %u, Reused: %u",
+			world.getStats().contactCount,
+			world.getStats().reusedContactCount);
+
+		const nph::ContactSolver::DirectSolveStats& directSolveStats =
+			world.getContactSolver().getDirectSolveStats();
+		ImGui::Text(
+			"Direct Islands: %u, Max Iterations: %u",
+			directSolveStats.islandCount,
+			directSolveStats.maxIterationCount);
+
 		float maxPenetration = 0.0f;
 		for (const auto& manifold : world.getContactSolver().getManifolds())
 		{
 			for (uint32_t i = 0; i < manifold.second.getContactCount(); ++i)
 			{
-				const auto& contact = manifold.second.getContact(i);
-				if (contact.getPoint().penetration > maxPenetration)
+				nph::Vec2 normal;
+				nph::Vec2 point;
+				float penetration;
+				manifold.second.getContact(i).getTransformedContact(
+					manifold.second.getBodyA(),
+					manifold.second.getBodyB(),
+					normal,
+					point,
+					penetration);
+
+				if (penetration > maxPenetration)
 				{
-					maxPenetration = contact.getPoint().penetration;
+					maxPenetration = penetration;
 				}
 			}
 		}
@@ -282,6 +350,46 @@ void drawGui(
 				&simulationControl.positionIterations,
 				0,
 				50);
+
+			ImGui::Checkbox(
+				"Speculative Contacts",
+				&simulationControl.speculativeContacts);
+
+			ImGui::Checkbox(
+				"Adaptive Substeps",
+				&simulationControl.adaptiveSubsteps);
+
+			ImGui::Checkbox(
+				"Contact Reuse",
+				&simulationControl.contactReuse);
+
+			ImGui::Combo(
+				"Velocity Solver",
+				&simulationControl.velocitySolver,
+				"Gauss-Seidel\0Jacobi\0");
+
+			ImGui::Combo(
+				"Position Solver",
+				&simulationControl.positionSolver,
+				"PBD\0Pseudo Velocities\0");
+
+			ImGui::SliderFloat(
+				"Jacobi Relaxation",
+				&simulationControl.jacobiRelaxation,
+				0.05f,
+				1.0f);
+
+			ImGui::SliderInt(
+				"Direct Solve Max Constraints",
+				&simulationControl.directSolveMaxConstraints,
+				0,
+				64);
+
+			ImGui::SliderInt(
+				"Shock Propagation Iterations",
+				&simulationControl.shockPropagationIterations,
+				0,
+				simulationControl.velocityIterations / 2);
 		}
 
 		if (ImGui::CollapsingHeader(
@@ -308,6 +416,10 @@ void drawGui(
 				100.0f,
 				500.0f,
 				"%.0f");
+
+			ImGui::Checkbox(
+				"Bullets",
+				&simulationControl.bulletBoxes);
 		}
 		ImGui::Unindent(20.0f);
 	}
@@ -339,6 +451,7 @@ int main()
 		nph::WorldDrawSettings drawSettings;
 		nph::SimulationControl simulationControl;
 		std::chrono::duration<float> lastPhyicsStepTime{ 0.0 };
+		auto lastFrameTime = std::chrono::high_resolution_clock::now();
 		while (visualization->isRunning())
 		{
 			if (simulationControl.resetWorld)
@@ -375,12 +488,49 @@ int main()
 			world.setPositionIterations(
 				uint32_t(simulationControl.positionIterations));
 
+			world.setSpeculativeContactsEnabled(
+				simulationControl.speculativeContacts);
+
+			world.setShockPropagationIterations(
+				uint32_t(simulationControl.shockPropagationIterations));
+
+			world.setVelocitySolver(
+				nph::VelocitySolver(simulationControl.velocitySolver));
+
+			world.setPositionSolver(
+				nph::PositionSolver(simulationControl.positionSolver));
+
+			world.setJacobiRelaxation(simulationControl.jacobiRelaxation);
+
+			world.setDirectSolveMaxConstraints(
+				uint32_t(simulationControl.directSolveMaxConstraints));
+
+			nph::ContactReuseSettings contactReuseSettings =
+				world.getContactReuseSettings();
+			contactReuseSettings.enabled = simulationControl.contactReuse;
+			world.setContactReuseSettings(contactReuseSettings);
+
+			nph::AdaptiveStepSettings adaptiveStepSettings =
+				world.getAdaptiveStepSettings();
+			adaptiveStepSettings.enabled = simulationControl.adaptiveSubsteps;
+			world.setAdaptiveStepSettings(adaptiveStepSettings);
+
+			world.setFixedTimeStep(1.0f / simulationControl.timeStepFrequency);
+
+			// The physics runs at the fixed rate regardless of the frame rate,
+			// the bodies are drawn interpolated between the steps
+			const auto frameTime = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<float> realTime = frameTime - lastFrameTime;
+			lastFrameTime = frameTime;
 			if (simulationControl.simulationRunning)
 			{
 				const auto tic = std::chrono::high_resolution_clock::now();
-				world.doStep(1.0f / simulationControl.timeStepFrequency);
+				const uint32_t stepCount = world.advance(realTime.count());
 				const auto toc = std::chrono::high_resolution_clock::now();
-				lastPhyicsStepTime = toc - tic;
+				if (stepCount > 0)
+				{
+					lastPhyicsStepTime = (toc - tic) / stepCount;
+				}
 			}
 		}
 		return 0;